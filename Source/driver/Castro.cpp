@@ -57,6 +57,12 @@
 
 #include <ambient.H>
 
+#include <clean_state.H>
+
+#ifdef HYBRID_MOMENTUM
+#include <hybrid.H>
+#endif
+
 using namespace amrex;
 
 bool         Castro::signalStopJob = false;
@@ -136,6 +142,7 @@ IntVect      Castro::no_tile_size(1024,1024,1024);
 // this records whether we have done tuning on the hydro tile size
 int          Castro::hydro_tile_size_has_been_tuned = 0;
 Long         Castro::largest_box_from_hydro_tile_size_tuning = 0;
+Vector<Castro::HydroTileTuning> Castro::hydro_tile_tuning;
 
 // this will be reset upon restart
 Real         Castro::previousCPUTimeUsed = 0.0;
@@ -192,6 +199,10 @@ Castro::variableCleanUp ()
   TracerPC = 0;
 #endif
 
+#ifndef MHD
+    release_ctu_scratch();
+#endif
+
     desc_lst.clear();
 
     // C++ cleaning
@@ -334,6 +345,18 @@ Castro::read_params ()
       amrex::Error("Invalid CFL factor; must be between zero and one.");
     }
 
+    // the Riemann solver is picked at compile time from these values
+    // in Castro::cmpflx_plus_godunov, so any other value would
+    // silently compute no fluxes
+
+    if (riemann_solver < 0 || riemann_solver > 2) {
+      amrex::Error("Invalid riemann_solver; must be 0, 1, or 2.");
+    }
+
+    if (hybrid_riemann != 0 && hybrid_riemann != 1) {
+      amrex::Error("Invalid hybrid_riemann; must be 0 or 1.");
+    }
+
     // SDC does not support GPUs yet
 #ifdef AMREX_USE_GPU
     if (time_integration_method == SpectralDeferredCorrections) {
@@ -1546,6 +1569,82 @@ Castro::estTimeStep (int is_new)
 
     Real estdt_hydro = max_dt / cfl;
 
+    // Figure out which of the limiters are active.
+
+    bool hydro_limited = do_hydro;
+#ifdef RADIATION
+    if (Radiation::rad_hydro_combined) {
+        // this has its own estimator below
+        hydro_limited = false;
+    }
+#endif
+
+    bool diffusion_limited = false;
+#ifdef DIFFUSION
+    diffusion_limited = diffuse_temp;
+#endif
+
+    bool burning_limited = false;
+#ifdef REACTIONS
+    burning_limited = do_react && (castro::dtnuc_e < 1.e199_rt || castro::dtnuc_X < 1.e199_rt);
+#endif
+
+    ValLocPair<Real, IntVect> hydro_dt{std::numeric_limits<Real>::max(), IntVect::TheZeroVector()};
+    ValLocPair<Real, IntVect> diffuse_dt{std::numeric_limits<Real>::max(), IntVect::TheZeroVector()};
+    ValLocPair<Real, IntVect> burn_dt{std::numeric_limits<Real>::max(), IntVect::TheZeroVector()};
+
+    if (fused_timestep_estimate == 1) {
+
+        if (hydro_limited || diffusion_limited || burning_limited) {
+
+            // All of the limiters in one sweep and one reduction.
+
+            auto fused_dt = estdt_fused(is_new, hydro_limited, diffusion_limited, burning_limited);
+
+            ParallelAllReduce::Min(fused_dt.data(), static_cast<int>(fused_dt.size()), MPI_COMM_WORLD);
+
+            hydro_dt = fused_dt[0];
+            diffuse_dt = fused_dt[1];
+            burn_dt = fused_dt[2];
+
+        }
+
+    } else {
+
+        if (hydro_limited) {
+#ifdef MHD
+            hydro_dt = estdt_mhd(is_new);
+#else
+            hydro_dt = estdt_cfl(is_new);
+#endif
+            ParallelAllReduce::Min(hydro_dt, MPI_COMM_WORLD);
+        }
+
+#ifdef DIFFUSION
+        if (diffusion_limited) {
+            diffuse_dt = estdt_temp_diffusion(is_new);
+            ParallelAllReduce::Min(diffuse_dt, MPI_COMM_WORLD);
+        }
+#endif
+
+#ifdef REACTIONS
+        if (burning_limited) {
+            burn_dt = estdt_burning(is_new);
+            ParallelAllReduce::Min(burn_dt, MPI_COMM_WORLD);
+        }
+#endif
+
+    }
+
+    std::string idx_str = "(i";
+#if AMREX_SPACEDIM >= 2
+    idx_str += ",j";
+#endif
+#if AMREX_SPACEDIM == 3
+    idx_str += ",k";
+#endif
+    idx_str += ")";
+
     if (do_hydro)
     {
 
@@ -1563,25 +1662,9 @@ Castro::estTimeStep (int is_new)
         {
 #endif
 
-#ifdef MHD
-          auto hydro_dt = estdt_mhd(is_new);
-#else
-          auto hydro_dt = estdt_cfl(is_new);
-#endif
-
-          amrex::ParallelAllReduce::Min(hydro_dt, MPI_COMM_WORLD);
           estdt_hydro = amrex::min(estdt_hydro, hydro_dt.value) * cfl;
           if (verbose) {
               amrex::Print() << "...estimated hydro-limited timestep at level " << level << ": " << estdt_hydro << std::endl;
-              std::string idx_str = "(i";
-#if AMREX_SPACEDIM >= 2
-              idx_str += ",j";
-#endif
-#if AMREX_SPACEDIM == 3
-              idx_str += ",k";
-#endif
-              idx_str += ")";
-
               amrex::Print() << "...hydro-limited CFL timestep constrained at " << idx_str << " = " << hydro_dt.index << std::endl;
           }
 
@@ -1606,25 +1689,13 @@ Castro::estTimeStep (int is_new)
 
     Real estdt_diffusion = max_dt / cfl;
 
-    if (diffuse_temp)
+    if (diffusion_limited)
     {
-        auto diffuse_dt = estdt_temp_diffusion(is_new);
-        ParallelAllReduce::Min(diffuse_dt, MPI_COMM_WORLD);
         estdt_diffusion = amrex::min(estdt_diffusion, diffuse_dt.value) * cfl;
 
         if (verbose) {
             amrex::Print() << "...estimated diffusion-limited timestep at level " << level << ": " << estdt_diffusion << std::endl;
-            std::string idx_str = "(i";
-#if AMREX_SPACEDIM >= 2
-            idx_str += ",j";
-#endif
-#if AMREX_SPACEDIM == 3
-            idx_str += ",k";
-#endif
-            idx_str += ")";
-
             amrex::Print() << "...diffusion-limited timestep constrained at " << idx_str << " = " << diffuse_dt.index << std::endl;
-
         }
     }
 
@@ -1640,26 +1711,14 @@ Castro::estTimeStep (int is_new)
     // Dummy value to start with
     Real estdt_burn = max_dt;
 
-    if (do_react && (castro::dtnuc_e < 1.e199_rt || castro::dtnuc_X < 1.e199_rt)) {
+    if (burning_limited) {
 
         // Compute burning-limited timestep.
 
-        auto burn_dt = estdt_burning(is_new);
-
-        ParallelAllReduce::Min(burn_dt, MPI_COMM_WORLD);
         estdt_burn = amrex::min(estdt_burn, burn_dt.value);
 
         if (verbose && estdt_burn < max_dt) {
             amrex::Print() << "...estimated burning-limited timestep at level " << level << ": " << estdt_burn << std::endl;
-            std::string idx_str = "(i";
-#if AMREX_SPACEDIM >= 2
-            idx_str += ",j";
-#endif
-#if AMREX_SPACEDIM == 3
-            idx_str += ",k";
-#endif
-            idx_str += ")";
-
             amrex::Print() << "...burning-limited timestep constrained at " << idx_str << " = " << burn_dt.index << std::endl;
         }
 
@@ -3096,38 +3155,10 @@ Castro::normalize_species (MultiFab& S_new, int ng)
         reduce_op.eval(bx, reduce_data,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
         {
-            Real rhoX_sum = 0.0_rt;
-            Real rhoInv = 1.0_rt / u(i,j,k,URHO);
-
             Real minX = 1.0_rt;
             Real maxX = 0.0_rt;
 
-            for (int n = 0; n < NumSpec; ++n) {
-                // Abort if X is unphysically large.
-                Real X = u(i,j,k,UFS+n) * rhoInv;
-
-                // Only do the abort check if the density is greater than a user-defined cutoff.
-                if (u(i,j,k,URHO) >= castro::abundance_failure_rho_cutoff) {
-                    minX = amrex::min(minX, X);
-                    maxX = amrex::max(maxX, X);
-
-                    if (X < -castro::abundance_failure_tolerance ||
-                        X > 1.0_rt + castro::abundance_failure_tolerance) {
-#ifndef AMREX_USE_GPU
-                        std::cout << "(i, j, k) = " << i << " " << j << " " << k << " " << ", X[" << n << "] = " << X << "  (density here is: " << u(i,j,k,URHO) << ")" << std::endl;
-#endif
-                    }
-                }
-
-                u(i,j,k,UFS+n) = amrex::max(lsmall_x * u(i,j,k,URHO), amrex::min(u(i,j,k,URHO), u(i,j,k,UFS+n)));
-                rhoX_sum += u(i,j,k,UFS+n);
-            }
-
-            Real fac = u(i,j,k,URHO) / rhoX_sum;
-
-            for (int n = 0; n < NumSpec; ++n) {
-                u(i,j,k,UFS+n) *= fac;
-            }
+            normalize_species_zone(i, j, k, u, lsmall_x, minX, maxX);
 
             return {minX, maxX};
         });
@@ -3137,10 +3168,7 @@ Castro::normalize_species (MultiFab& S_new, int ng)
     Real minX = amrex::get<0>(hv);
     Real maxX = amrex::get<1>(hv);
 
-    if (minX < -castro::abundance_failure_tolerance ||
-        maxX > 1.0_rt + castro::abundance_failure_tolerance) {
-        amrex::Error("Invalid mass fraction in Castro::normalize_species()");
-    }
+    check_species_range(minX, maxX, "normalize_species");
 }
 
 void
@@ -3349,26 +3377,7 @@ Castro::enforce_speed_limit (MultiFab& state_in, int ng)
         amrex::ParallelFor(bx,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            Real rho = u(i,j,k,URHO);
-            Real rhoInv = 1.0_rt / rho;
-
-            Real vx = u(i,j,k,UMX) * rhoInv;
-            Real vy = u(i,j,k,UMY) * rhoInv;
-            Real vz = u(i,j,k,UMZ) * rhoInv;
-
-            Real v = std::sqrt(vx * vx + vy * vy + vz * vz);
-
-            if (v > castro::speed_limit) {
-                Real reduce_factor = castro::speed_limit / v;
-
-                u(i,j,k,UMX) *= reduce_factor;
-                u(i,j,k,UMY) *= reduce_factor;
-                u(i,j,k,UMZ) *= reduce_factor;
-
-                u(i,j,k,UEDEN) -= 0.5_rt * rhoInv * (rho * vx * rho * vx - u(i,j,k,UMX) * u(i,j,k,UMX) +
-                                                     rho * vy * rho * vy - u(i,j,k,UMY) * u(i,j,k,UMY) +
-                                                     rho * vz * rho * vz - u(i,j,k,UMZ) * u(i,j,k,UMZ));
-            }
+            enforce_speed_limit_zone(i, j, k, u, castro::speed_limit);
         });
     }
 }
@@ -3673,60 +3682,16 @@ Castro::reset_internal_energy(const Box& bx,
 {
     BL_PROFILE("Castro::reset_internal_energy(Fab)");
 
-    Real lsmall_temp = small_temp;
-    Real ldual_energy_eta2 = dual_energy_eta2;
-
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-        Real rhoInv = 1.0_rt / u(i,j,k,URHO);
-        Real Up = u(i,j,k,UMX) * rhoInv;
-        Real Vp = u(i,j,k,UMY) * rhoInv;
-        Real Wp = u(i,j,k,UMZ) * rhoInv;
-        Real ke = 0.5_rt * (Up * Up + Vp * Vp + Wp * Wp);
-
-        eos_re_t eos_state;
-
-        eos_state.rho = u(i,j,k,URHO);
-        eos_state.T   = lsmall_temp;
-        for (int n = 0; n < NumSpec; ++n) {
-            eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
-        }
-#if NAUX_NET > 0
-        for (int n = 0; n < NumAux; ++n) {
-            eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
-        }
-#endif
-
-        eos(eos_input_rt, eos_state);
-
-        Real small_e = eos_state.e;
-
 #ifdef MHD
-        Real bx_cell_c = 0.5_rt * (Bx(i,j,k) + Bx(i+1,j,k));
-        Real by_cell_c = 0.5_rt * (By(i,j,k) + By(i,j+1,k));
-        Real bz_cell_c = 0.5_rt * (Bz(i,j,k) + Bz(i,j,k+1));
-
-        Real B_ener = 0.5_rt * (bx_cell_c*bx_cell_c +
-                                by_cell_c*by_cell_c +
-                                bz_cell_c*bz_cell_c);
+        Real B_ener = magnetic_energy_zone(i, j, k, Bx, By, Bz);
 #else
         Real B_ener = 0.0_rt;
 #endif
 
-        // Ensure the internal energy is at least as large as this minimum
-        // from the EOS; the same holds true for the total energy.
-
-        u(i,j,k,UEINT) = amrex::max(u(i,j,k,UEINT), u(i,j,k,URHO) * small_e);
-        u(i,j,k,UEDEN) = amrex::max(u(i,j,k,UEDEN), u(i,j,k,URHO) * (small_e + ke) + B_ener);
-
-        // Apply the dual energy criterion: get e from E if (E - K) > eta * E.
-
-        Real rho_eint = u(i,j,k,UEDEN) - u(i,j,k,URHO) * ke - B_ener;
-
-        if (rho_eint > ldual_energy_eta2 * u(i,j,k,UEDEN)) {
-            u(i,j,k,UEINT) = rho_eint;
-        }
+        reset_internal_energy_zone(i, j, k, u, B_ener);
     });
 }
 
@@ -3996,42 +3961,14 @@ Castro::computeTemp(
       amrex::ParallelFor(bx,
       [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
       {
-
-          Real rhoInv = 1.0_rt / u(i,j,k,URHO);
-
-          eos_re_t eos_state;
-
-          eos_state.rho = u(i,j,k,URHO);
-          eos_state.T   = u(i,j,k,UTEMP); // Initial guess for the EOS
-          eos_state.e   = u(i,j,k,UEINT) * rhoInv;
-          for (int n = 0; n < NumSpec; ++n) {
-            eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
-          }
-#if NAUX_NET > 0
-          for (int n = 0; n < NumAux; ++n) {
-            eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
-          }
-#endif
-
-          eos(eos_input_re, eos_state);
-
-          u(i,j,k,UTEMP) = eos_state.T;
-
+          compute_temp_zone(i, j, k, u);
       });
 
       if (clamp_ambient_temp == 1) {
           amrex::ParallelFor(bx,
           [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
           {
-              Real rhoInv = 1.0_rt / u(i,j,k,URHO);
-
-              if (u(i,j,k,URHO) <= castro::ambient_safety_factor * ambient::ambient_state[URHO]) {
-                  u(i,j,k,UTEMP) = ambient::ambient_state[UTEMP];
-                  u(i,j,k,UEINT) = ambient::ambient_state[UEINT] * (u(i,j,k,URHO) * rhoInv);
-                  u(i,j,k,UEDEN) = u(i,j,k,UEINT) + 0.5_rt * rhoInv * (u(i,j,k,UMX) * u(i,j,k,UMX) +
-                                                                       u(i,j,k,UMY) * u(i,j,k,UMY) +
-                                                                       u(i,j,k,UMZ) * u(i,j,k,UMZ));
-              }
+              clamp_ambient_temp_zone(i, j, k, u);
           });
       }
   }
@@ -4458,6 +4395,27 @@ Castro::clean_state(
 
     BL_PROFILE("Castro::clean_state()");
 
+    // All of the cleaning steps below are purely local to a zone, so
+    // if possible we do them in a single pass over the data.  The
+    // per-operation update diagnostics and the fourth-order temperature
+    // update need the individual steps, so they use the separate sweeps.
+
+    bool use_fused = fused_clean_state == 1 && !print_update_diagnostics;
+#ifdef TRUE_SDC
+    if (sdc_order == 4) {
+        use_fused = false;
+    }
+#endif
+
+    if (use_fused) {
+        clean_state_fused(
+#ifdef MHD
+                          bx, by, bz,
+#endif
+                          state_in, ng);
+        return;
+    }
+
     // Enforce a minimum density.
 
     enforce_min_density(state_in, ng);
@@ -4489,6 +4447,98 @@ Castro::clean_state(
 
 }
 
+void
+Castro::clean_state_fused(
+#ifdef MHD
+                          MultiFab& Bx,
+                          MultiFab& By,
+                          MultiFab& Bz,
+#endif
+                          MultiFab& state_in, int ng) {
+
+    BL_PROFILE("Castro::clean_state_fused()");
+
+    // This does, zone by zone, exactly the same operations as
+    // enforce_min_density, enforce_speed_limit, normalize_species,
+    // hybrid_to_linear_momentum, reset_internal_energy, and computeTemp
+    // (in that order), so the result is identical to the separate
+    // sweeps, but the state is only read and written once.
+
+    GeometryData geomdata = geom.data();
+#ifdef HYBRID_MOMENTUM
+    const int lhybrid_hydro = hybrid_hydro;
+#endif
+
+    const int verbose_warnings = verbose;
+    const Real lsmall_x = network_rp::small_x;
+    const Real lspeed_limit = castro::speed_limit;
+    const int lclamp_ambient_temp = clamp_ambient_temp;
+
+    ReduceOps<ReduceOpMin, ReduceOpMax> reduce_op;
+    ReduceData<Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(state_in, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(ng);
+
+        auto u = state_in.array(mfi);
+
+#ifdef MHD
+        auto Bx_arr = Bx.const_array(mfi);
+        auto By_arr = By.const_array(mfi);
+        auto Bz_arr = Bz.const_array(mfi);
+#endif
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            enforce_min_density_zone(i, j, k, bx, u, geomdata, verbose_warnings);
+
+            if (lspeed_limit > 0.0_rt) {
+                enforce_speed_limit_zone(i, j, k, u, lspeed_limit);
+            }
+
+            Real minX = 1.0_rt;
+            Real maxX = 0.0_rt;
+
+            normalize_species_zone(i, j, k, u, lsmall_x, minX, maxX);
+
+#ifdef HYBRID_MOMENTUM
+            if (lhybrid_hydro) {
+                hybrid_to_linear_momentum_zone(i, j, k, u, geomdata);
+            }
+#endif
+
+#ifdef MHD
+            Real B_ener = magnetic_energy_zone(i, j, k, Bx_arr, By_arr, Bz_arr);
+#else
+            Real B_ener = 0.0_rt;
+#endif
+
+            reset_internal_energy_zone(i, j, k, u, B_ener);
+
+            compute_temp_zone(i, j, k, u);
+
+            if (lclamp_ambient_temp == 1) {
+                clamp_ambient_temp_zone(i, j, k, u);
+            }
+
+            return {minX, maxX};
+        });
+    }
+
+    ReduceTuple hv = reduce_data.value();
+    Real minX = amrex::get<0>(hv);
+    Real maxX = amrex::get<1>(hv);
+
+    check_species_range(minX, maxX, "clean_state_fused");
+
+}
+
 void
 Castro::save_data_for_retry ()
 {
@@ -5,6 +5,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <ctime>
 #include <filesystem>
@@ -171,6 +172,72 @@ Castro::restart (Amr&     papa,
 
     }
 
+#ifndef AMREX_USE_GPU
+    // reuse the hydro tile sizes found by the autotuner in the
+    // previous run -- these are recorded in the job_info file
+
+    if (level == 0 && castro::hydro_tile_size_autotune == 1)
+    {
+      Vector<int> tuned;
+
+      if (ParallelDescriptor::IOProcessor()) {
+          std::ifstream JobInfoFile;
+          std::string FullPathJobInfoFile = parent->theRestartFile();
+          FullPathJobInfoFile += "/job_info";
+          JobInfoFile.open(FullPathJobInfoFile.c_str(), std::ios::in);
+
+          const std::string prefix = "autotuned hydro tile size, level ";
+          std::string line;
+
+          while (JobInfoFile.good() && std::getline(JobInfoFile, line)) {
+              if (line.rfind(prefix, 0) != 0) {
+                  continue;
+              }
+
+              std::istringstream is(line.substr(prefix.size()));
+              int lev;
+              char colon;
+              std::string word;
+              IntVect tile_size, max_box_length;
+              is >> lev >> colon >> tile_size >> word >> word >> word >> word >> max_box_length;
+
+              if (is) {
+                  tuned.push_back(lev);
+                  for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                      tuned.push_back(tile_size[idir]);
+                  }
+                  for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                      tuned.push_back(max_box_length[idir]);
+                  }
+              }
+          }
+      }
+
+      int ntuned = static_cast<int>(tuned.size());
+      ParallelDescriptor::Bcast(&ntuned, 1, ParallelDescriptor::IOProcessorNumber());
+      tuned.resize(ntuned);
+      if (ntuned > 0) {
+          ParallelDescriptor::Bcast(tuned.dataPtr(), ntuned, ParallelDescriptor::IOProcessorNumber());
+      }
+
+      for (int n = 0; n < ntuned; n += 2 * AMREX_SPACEDIM + 1) {
+          const int lev = tuned[n];
+          if (static_cast<int>(hydro_tile_tuning.size()) <= lev) {
+              hydro_tile_tuning.resize(lev + 1);
+          }
+          auto& tuning = hydro_tile_tuning[lev];
+          for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+              tuning.tile_size[idir] = tuned[n + 1 + idir];
+              tuning.max_box_length[idir] = tuned[n + 1 + AMREX_SPACEDIM + idir];
+          }
+          tuning.locked = true;
+
+          amrex::Print() << "  Based on the checkpoint, using hydro tile size " << tuning.tile_size
+                         << " on level " << lev << "\n";
+      }
+    }
+#endif
+
 #ifdef GRAVITY
     if (use_point_mass && level == 0)
     {
@@ -563,6 +630,12 @@ Castro::writeJobInfo (const std::string& dir, const Real io_time)
 #endif
   jobInfoFile << "\n";
   jobInfoFile << "hydro tile size:         " << hydro_tile_size << "\n";
+  for (int lev = 0; lev < static_cast<int>(hydro_tile_tuning.size()); ++lev) {
+      if (hydro_tile_tuning[lev].locked) {
+          jobInfoFile << "autotuned hydro tile size, level " << lev << ": " << hydro_tile_tuning[lev].tile_size
+                      << " for boxes up to " << hydro_tile_tuning[lev].max_box_length << "\n";
+      }
+  }
 
   jobInfoFile << "\n";
   jobInfoFile << "CPU time used since start of simulation (CPU-hours): " <<
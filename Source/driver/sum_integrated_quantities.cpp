@@ -54,211 +54,104 @@ Castro::sum_integrated_quantities ()
     int fixwidth     = 25; // Floating point data not in scientific notation
     int intwidth     = 12; // Integer data
 
-    for (int lev = 0; lev <= finest_level; lev++)
-    {
-        Castro& ca_lev = getLevel(lev);
-        MultiFab& S_new = ca_lev.get_new_data(State_Type);
-#ifdef GRAVITY
-        MultiFab& phi_new = ca_lev.get_new_data(PhiGrav_Type);
-#endif
-#ifdef REACTIONS
-        MultiFab& R_new = ca_lev.get_new_data(Reactions_Type);
-#endif
+    // All of the integrals and extrema reported below are gathered
+    // in a single sweep over each level and then reduced with one
+    // MPI call.
 
-        mass   += ca_lev.volWgtSum(S_new, URHO, local_flag);
-        mom[0] += ca_lev.volWgtSum(S_new, UMX, local_flag);
-        mom[1] += ca_lev.volWgtSum(S_new, UMY, local_flag);
-        mom[2] += ca_lev.volWgtSum(S_new, UMZ, local_flag);
+    SumReduction sums;
 
-        ang_mom[0] += ca_lev.volWgtSum("angular_momentum_x", time, local_flag);
-        ang_mom[1] += ca_lev.volWgtSum("angular_momentum_y", time, local_flag);
-        ang_mom[2] += ca_lev.volWgtSum("angular_momentum_z", time, local_flag);
+    const int i_mass = sums.vol_sum(URHO);
 
+    int i_mom[3];
+    int i_ang_mom[3];
+    int i_com[3];
 #ifdef HYBRID_MOMENTUM
-        hyb_mom[0] += ca_lev.volWgtSum(S_new, UMR, local_flag);
-        hyb_mom[1] += ca_lev.volWgtSum(S_new, UML, local_flag);
-        hyb_mom[2] += ca_lev.volWgtSum(S_new, UMP, local_flag);
-#endif
-
-        com[0] += ca_lev.locWgtSum(S_new, URHO, 0, local_flag);
-        com[1] += ca_lev.locWgtSum(S_new, URHO, 1, local_flag);
-        com[2] += ca_lev.locWgtSum(S_new, URHO, 2, local_flag);
-
-        rho_e += ca_lev.volWgtSum(S_new, UEINT, local_flag);
-        rho_K += ca_lev.volWgtSum("kineng", time, local_flag);
-        rho_E += ca_lev.volWgtSum(S_new, UEDEN, local_flag);
-#ifdef GRAVITY
-        if (gravity->get_gravity_type() == "PoissonGrav") {
-            rho_phi += ca_lev.volProductSum(S_new, phi_new, URHO, 0, local_flag);
-        }
+    int i_hyb_mom[3];
 #endif
 
-        // Compute extrema
-
-#ifdef REACTIONS
-        auto dx = ca_lev.geom.CellSizeArray();
-
-        Real dd = 0.0_rt;
-#if AMREX_SPACEDIM == 1
-        dd = dx[0];
-#elif AMREX_SPACEDIM == 2
-        dd = amrex::min(dx[0], dx[1]);
-#else
-        dd = amrex::min(dx[0], dx[1], dx[2]);
-#endif
+    for (int idir = 0; idir < 3; ++idir) {
+        i_mom[idir] = sums.vol_sum(UMX + idir);
+    }
+    for (int idir = 0; idir < 3; ++idir) {
+        i_com[idir] = sums.loc_sum(URHO, idir);
+    }
+    for (int idir = 0; idir < 3; ++idir) {
+        i_ang_mom[idir] = sums.angular_momentum(idir);
+    }
+#ifdef HYBRID_MOMENTUM
+    for (int idir = 0; idir < 3; ++idir) {
+        i_hyb_mom[idir] = sums.vol_sum(UMR + idir);
+    }
 #endif
 
-        bool mask_available = true;
-        if (lev == parent->finestLevel()) {
-            mask_available = false;
-        }
-
-        MultiFab tmp_mf;
-        const MultiFab& mask_mf = mask_available ? getLevel(lev+1).build_fine_mask() : tmp_mf;
-
-        ReduceOps<ReduceOpMax, ReduceOpMax, ReduceOpMax> reduce_op;
-        ReduceData<Real, Real, Real> reduce_data(reduce_op);
-        using ReduceTuple = typename decltype(reduce_data)::Type;
+    const int i_rho_e = sums.vol_sum(UEINT);
+    const int i_rho_K = sums.kinetic_energy();
+    const int i_rho_E = sums.vol_sum(UEDEN);
+#ifdef GRAVITY
+    const int i_rho_phi = (gravity->get_gravity_type() == "PoissonGrav" || gravity->get_gravity_type() == "MultipoleGrav" ||
+                            gravity->get_gravity_type() == "PointMassGrav") ? sums.phi_sum(URHO) : -1;
 
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-        for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-            const Box& bx = mfi.tilebox();
+    // the gravitational wave strain is computed separately, but is
+    // reduced along with everything else
 
-            auto U = S_new[mfi].array();
-#ifdef REACTIONS
-            auto R = R_new[mfi].array();
+    int i_h[6];
+    for (int& n : i_h) {
+        n = sums.user_sum();
+    }
 #endif
 
-            const auto & level_mask = mask_available ? mask_mf[mfi].array() : Array4<Real>{};
-
-            reduce_op.eval(bx, reduce_data,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
-            {
-                Real maskFactor = 1.0;
-                if (mask_available) {
-                    maskFactor = level_mask(i,j,k);
-                }
-
-                Real T = U(i,j,k,UTEMP) * maskFactor;
-                Real rho = U(i,j,k,URHO) * maskFactor;
-                Real ts_te = 0.0_rt;
+    std::vector<int> i_species(NumSpec);
+    for (int i = 0; i < NumSpec; ++i) {
+        i_species[i] = sums.vol_sum(UFS + i);
+    }
 
+    const int i_T_max = sums.max(UTEMP);
+    const int i_rho_max = sums.max(URHO);
 #ifdef REACTIONS
-                Real enuc = std::abs(R(i,j,k,0)) / U(i,j,k,URHO);
-
-                if (enuc > 1.e-100_rt && maskFactor == 1.0) {
-
-                    Real rhoInv = 1.0_rt / rho;
-
-                    // Calculate sound speed
-                    eos_rep_t eos_state;
-                    eos_state.rho = rho;
-                    eos_state.T   = T;
-                    eos_state.e   = U(i,j,k,UEINT) * rhoInv;
-                    for (int n = 0; n < NumSpec; ++n) {
-                        eos_state.xn[n] = U(i,j,k,UFS+n) * rhoInv;
-                    }
-#if NAUX_NET > 0
-                    for (int n = 0; n < NumAux; ++n) {
-                        eos_state.aux[n] = U(i,j,k,UFX+n) * rhoInv;
-                    }
-#endif
-
-                    eos(eos_input_re, eos_state);
-
-                    Real t_e = eos_state.e / enuc;
-                    Real t_s = dd / eos_state.cs;
-
-                    ts_te = t_s / t_e;
-                }
+    const int i_ts_te_max = sums.ts_te_max();
 #endif
 
-                return {T, rho, ts_te};
-            });
-
-        }
+    for (int lev = 0; lev <= finest_level; lev++)
+    {
+        Castro& ca_lev = getLevel(lev);
 
-        ReduceTuple hv = reduce_data.value();
+        ca_lev.accumulate_sums(sums);
 
-        T_max = amrex::max(T_max, amrex::get<0>(hv));
-        rho_max = amrex::max(rho_max, amrex::get<1>(hv));
-#ifdef REACTIONS
-        ts_te_max = amrex::max(ts_te_max, amrex::get<2>(hv));
+#if defined(GRAVITY) && (AMREX_SPACEDIM > 1)
+        // Gravitational wave signal. This is designed to add to these quantities so we can send them directly.
+        auto& h = sums.sum_data();
+        ca_lev.gwstrain(time, h[i_h[0]], h[i_h[1]], h[i_h[2]], h[i_h[3]], h[i_h[4]], h[i_h[5]], local_flag);
 #endif
-
     }
 
+    sums.reduce(ParallelDescriptor::IOProcessorNumber());
+
     if (verbose > 0)
     {
 
-#ifdef HYBRID_MOMENTUM
-#ifdef GRAVITY
-       const int nfoo = 17;
-#else
-       const int nfoo = 16;
-#endif
-#else
-#ifdef GRAVITY
-       const int nfoo = 14;
-#else
-       const int nfoo = 13;
-#endif
-#endif
-
-        Real foo[nfoo] = {mass, mom[0], mom[1], mom[2],
-                          com[0], com[1], com[2],
-                          ang_mom[0], ang_mom[1], ang_mom[2],
-#ifdef HYBRID_MOMENTUM
-                          hyb_mom[0], hyb_mom[1], hyb_mom[2],
-#endif
-#ifdef GRAVITY
-                          rho_e, rho_K, rho_E, rho_phi};
-#else
-                          rho_e, rho_K, rho_E};
-#endif
-
-        const int nfoo_max = 3;
-
-        Real foo_max[nfoo_max] = {T_max, rho_max, ts_te_max};
-
-#ifdef BL_LAZY
-        Lazy::QueueReduction( [=] () mutable {
-#endif
-
-        ParallelDescriptor::ReduceRealSum(foo, nfoo, ParallelDescriptor::IOProcessorNumber());
-
-        ParallelDescriptor::ReduceRealMax(foo_max, nfoo_max, ParallelDescriptor::IOProcessorNumber());
-
         if (ParallelDescriptor::IOProcessor()) {
 
-            int i = 0;
-            mass       = foo[i++];
-            mom[0]     = foo[i++];
-            mom[1]     = foo[i++];
-            mom[2]     = foo[i++];
-            com[0]     = foo[i++];
-            com[1]     = foo[i++];
-            com[2]     = foo[i++];
-            ang_mom[0] = foo[i++];
-            ang_mom[1] = foo[i++];
-            ang_mom[2] = foo[i++];
+            mass = sums.sum(i_mass);
+            for (int idir = 0; idir < 3; idir++) {
+                mom[idir]     = sums.sum(i_mom[idir]);
+                com[idir]     = sums.sum(i_com[idir]);
+                ang_mom[idir] = sums.sum(i_ang_mom[idir]);
 #ifdef HYBRID_MOMENTUM
-            hyb_mom[0] = foo[i++];
-            hyb_mom[1] = foo[i++];
-            hyb_mom[2] = foo[i++];
+                hyb_mom[idir] = sums.sum(i_hyb_mom[idir]);
 #endif
-            rho_e      = foo[i++];
-            rho_K      = foo[i++];
-            rho_E      = foo[i++];
+            }
+            rho_e      = sums.sum(i_rho_e);
+            rho_K      = sums.sum(i_rho_K);
+            rho_E      = sums.sum(i_rho_E);
 #ifdef GRAVITY
-            rho_phi    = foo[i++];
+            if (i_rho_phi >= 0) {
+                rho_phi = sums.sum(i_rho_phi);
+            }
 
             // Total energy is 1/2 * rho * phi + rho * E for self-gravity,
             // and rho * phi + rho * E for externally-supplied gravity.
             std::string gravity_type = gravity->get_gravity_type();
-            if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav") {
+            if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav" || gravity_type == "MultipoleGrav") {
                 total_energy = 0.5 * rho_phi + rho_E;
             }
             else {
@@ -271,10 +164,11 @@ Castro::sum_integrated_quantities ()
                 com_vel[idir] = mom[idir] / mass;
             }
 
-            i = 0;
-            T_max     = foo_max[i++];
-            rho_max   = foo_max[i++];
-            ts_te_max = foo_max[i++];    // NOLINT(clang-analyzer-deadcode.DeadStores)
+            T_max     = amrex::max(T_max, sums.extremum(i_T_max));
+            rho_max   = amrex::max(rho_max, sums.extremum(i_rho_max));
+#ifdef REACTIONS
+            ts_te_max = amrex::max(ts_te_max, sums.extremum(i_ts_te_max));
+#endif
 
             std::cout << '\n';
             std::cout << "TIME= " << time << " MASS        = "   << mass      << '\n';
@@ -295,6 +189,12 @@ Castro::sum_integrated_quantities ()
 #ifdef GRAVITY
             std::cout << "TIME= " << time << " RHO*PHI     = "   << rho_phi   << '\n';
             std::cout << "TIME= " << time << " TOTAL ENERGY= "   << total_energy << '\n';
+            if (gravity_type == "PoissonGrav" && gravity::sync_interval > 1) {
+                Real skipped_mass, skipped_abs_mass;
+                gravity->get_skipped_sync_mass(skipped_mass, skipped_abs_mass);
+                std::cout << "TIME= " << time << " SKIPPED SYNC MASS   = " << skipped_mass << '\n';
+                std::cout << "TIME= " << time << " SKIPPED SYNC |MASS| = " << skipped_abs_mass << '\n';
+            }
 #endif
             std::cout << "TIME= " << time << " CENTER OF MASS X-LOC = " << com[0]     << '\n';
             std::cout << "TIME= " << time << " CENTER OF MASS X-VEL = " << com_vel[0] << '\n';
@@ -420,9 +320,6 @@ Castro::sum_integrated_quantities ()
 
             }
         }
-#ifdef BL_LAZY
-        });
-#endif
     }
 
 #ifdef GRAVITY
@@ -430,45 +327,14 @@ Castro::sum_integrated_quantities ()
     {
         // Gravitational wave amplitudes
 
-        Real h_plus_1  = 0.0;
-        Real h_cross_1 = 0.0;
-
-        Real h_plus_2  = 0.0;
-        Real h_cross_2 = 0.0;
-
-        Real h_plus_3  = 0.0;
-        Real h_cross_3 = 0.0;
-
-        for (int lev = 0; lev <= finest_level; lev++)
-        {
-            Castro& ca_lev = getLevel(lev);
-
-#if (AMREX_SPACEDIM > 1)
-            // Gravitational wave signal. This is designed to add to these quantities so we can send them directly.
-            ca_lev.gwstrain(time, h_plus_1, h_cross_1, h_plus_2, h_cross_2, h_plus_3, h_cross_3, local_flag);
-#endif
-
-        }
-
-        const int nfoo_sum = 6;
+        Real h_plus_1  = sums.sum(i_h[0]);
+        Real h_cross_1 = sums.sum(i_h[1]);
 
-        amrex::Vector<Real> foo_sum(nfoo_sum);
+        Real h_plus_2  = sums.sum(i_h[2]);
+        Real h_cross_2 = sums.sum(i_h[3]);
 
-        foo_sum[0] = h_plus_1;
-        foo_sum[1] = h_cross_1;
-        foo_sum[2] = h_plus_2;
-        foo_sum[3] = h_cross_2;
-        foo_sum[4] = h_plus_3;
-        foo_sum[5] = h_cross_3;
-
-        amrex::ParallelDescriptor::ReduceRealSum(foo_sum.dataPtr(), nfoo_sum);
-
-        h_plus_1   = foo_sum[0];
-        h_cross_1  = foo_sum[1];
-        h_plus_2   = foo_sum[2];
-        h_cross_2  = foo_sum[3];
-        h_plus_3   = foo_sum[4];
-        h_cross_3  = foo_sum[5];
+        Real h_plus_3  = sums.sum(i_h[4]);
+        Real h_cross_3 = sums.sum(i_h[5]);
 
         if (ParallelDescriptor::IOProcessor()) {
 
@@ -547,30 +413,12 @@ Castro::sum_integrated_quantities ()
         for (int i = 0; i < NumSpec; i++) {
             species_names[i] = desc_lst[State_Type].name(UFS+i);
             species_names[i] = species_names[i].substr(4,std::string::npos);
-            species_mass[i] = 0.0;
         }
 
         // Integrated mass of all species on the domain
 
-        for (int lev = 0; lev <= finest_level; ++lev) {
-            MultiFab& S_new = getLevel(lev).get_new_data(State_Type);
-            for (int i = 0; i < NumSpec; ++i) {
-                species_mass[i] += getLevel(lev).volWgtSum(S_new, UFS + i, local_flag) / C::M_solar;
-            }
-        }
-
-        int nfoo_sum = NumSpec;
-
-        amrex::Vector<Real> foo_sum(nfoo_sum);
-
-        for (int i = 0; i < NumSpec; ++i) {
-            foo_sum[i] = species_mass[i];
-        }
-
-        amrex::ParallelDescriptor::ReduceRealSum(foo_sum.dataPtr(), nfoo_sum);
-
         for (int i = 0; i < NumSpec; ++i) {
-            species_mass[i] = foo_sum[i];
+            species_mass[i] = sums.sum(i_species[i]) / C::M_solar;
         }
 
         if (ParallelDescriptor::IOProcessor()) {
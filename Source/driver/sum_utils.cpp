@@ -309,7 +309,177 @@ Castro::locSquaredSum (const std::string& name,
     return sum;
 }
 
+void
+Castro::accumulate_sums (SumReduction& sums, bool finemask)
+{
+    BL_PROFILE("Castro::accumulate_sums()");
+
+    const int nsum = sums.num_sums();
+    const int next = sums.num_extrema();
+
+    if (nsum + next == 0) {
+        return;
+    }
+
+    bool mask_available = level < parent->finestLevel() && finemask;
+
+    MultiFab tmp_mf;
+    const MultiFab& mask_mf = mask_available ? getLevel(level+1).build_fine_mask() : tmp_mf;
+
+    const MultiFab& S_new = get_new_data(State_Type);
+#ifdef GRAVITY
+    const MultiFab& phi_new = get_new_data(PhiGrav_Type);
+#endif
+#ifdef REACTIONS
+    const MultiFab& R_new = get_new_data(Reactions_Type);
+#endif
+
+    auto dx     = geom.CellSizeArray();
+    auto problo = geom.ProbLoArray();
+
+    Vector<Real>& sum_data = sums.sum_data();
+    Vector<Real>& ext_data = sums.extremum_data();
+
+#ifdef AMREX_USE_GPU
+
+    // All of the quantities are evaluated in the same kernel, with
+    // each one doing its own block reduction into device memory.
+
+    Gpu::DeviceVector<SumQuantity> sum_q(nsum);
+    Gpu::DeviceVector<SumQuantity> ext_q(next);
+
+    Gpu::copyAsync(Gpu::hostToDevice, sums.sum_quantities().begin(), sums.sum_quantities().end(), sum_q.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, sums.extremum_quantities().begin(), sums.extremum_quantities().end(), ext_q.begin());
+
+    Gpu::DeviceVector<Real> sum_d(nsum, 0.0_rt);
+    Gpu::DeviceVector<Real> ext_d(next, std::numeric_limits<Real>::lowest());
+
+    const SumQuantity* sum_q_p = sum_q.dataPtr();
+    const SumQuantity* ext_q_p = ext_q.dataPtr();
+    Real* sum_p = sum_d.dataPtr();
+    Real* ext_p = ext_d.dataPtr();
+
+    for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& box = mfi.tilebox();
+
+        auto const U = S_new.array(mfi);
+#ifdef GRAVITY
+        auto const phi = phi_new.array(mfi);
+#else
+        auto const phi = Array4<Real const>{};
+#endif
+#ifdef REACTIONS
+        auto const R = R_new.array(mfi);
+#else
+        auto const R = Array4<Real const>{};
+#endif
+        auto const& vol = volume.array(mfi);
+        auto const& mask = mask_available ? mask_mf.array(mfi) : Array4<Real const>{};
+
+        amrex::ParallelFor(Gpu::KernelInfo().setReduction(true), box,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, Gpu::Handler const& handler) noexcept
+        {
+            Real maskFactor = mask_available ? mask(i,j,k) : 1.0_rt;
+
+            for (int n = 0; n < nsum; ++n) {
+                Real val = 0.0_rt;
+                if (sum_q_p[n].kind != sum_reduction::user_sum) {
+                    val = sum_quantity_value(sum_q_p[n], i, j, k, U, phi, R, problo, dx, maskFactor) *
+                          vol(i,j,k) * maskFactor;
+                }
+                Gpu::deviceReduceSum(sum_p + n, val, handler);
+            }
+
+            for (int n = 0; n < next; ++n) {
+                Real val = sum_quantity_value(ext_q_p[n], i, j, k, U, phi, R, problo, dx, maskFactor);
+                Gpu::deviceReduceMax(ext_p + n, val, handler);
+            }
+        });
+    }
+
+    Vector<Real> sum_h(nsum);
+    Vector<Real> ext_h(next);
+
+    Gpu::copyAsync(Gpu::deviceToHost, sum_d.begin(), sum_d.end(), sum_h.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, ext_d.begin(), ext_d.end(), ext_h.begin());
+    Gpu::streamSynchronize();
+
+    for (int n = 0; n < nsum; ++n) {
+        sum_data[n] += sum_h[n];
+    }
+
+    for (int n = 0; n < next; ++n) {
+        ext_data[n] = amrex::max(ext_data[n], ext_h[n]);
+    }
+
+#else
+
+    const auto& sum_q = sums.sum_quantities();
+    const auto& ext_q = sums.extremum_quantities();
 
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+        // Each thread accumulates into its own copy and then we
+        // merge them at the end.
+
+        Vector<Real> sum_t(nsum, 0.0_rt);
+        Vector<Real> ext_t(next, std::numeric_limits<Real>::lowest());
+
+        for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& box = mfi.tilebox();
+
+            auto const U = S_new.array(mfi);
+#ifdef GRAVITY
+            auto const phi = phi_new.array(mfi);
+#else
+            auto const phi = Array4<Real const>{};
+#endif
+#ifdef REACTIONS
+            auto const R = R_new.array(mfi);
+#else
+            auto const R = Array4<Real const>{};
+#endif
+            auto const& vol = volume.array(mfi);
+            auto const& mask = mask_available ? mask_mf.array(mfi) : Array4<Real const>{};
+
+            amrex::LoopOnCpu(box, [&] (int i, int j, int k) noexcept
+            {
+                Real maskFactor = mask_available ? mask(i,j,k) : 1.0_rt;
+
+                for (int n = 0; n < nsum; ++n) {
+                    if (sum_q[n].kind != sum_reduction::user_sum) {
+                        sum_t[n] += sum_quantity_value(sum_q[n], i, j, k, U, phi, R, problo, dx, maskFactor) *
+                                    vol(i,j,k) * maskFactor;
+                    }
+                }
+
+                for (int n = 0; n < next; ++n) {
+                    ext_t[n] = amrex::max(ext_t[n],
+                                          sum_quantity_value(ext_q[n], i, j, k, U, phi, R, problo, dx, maskFactor));
+                }
+            });
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp critical (castro_accumulate_sums)
+#endif
+        {
+            for (int n = 0; n < nsum; ++n) {
+                sum_data[n] += sum_t[n];
+            }
+
+            for (int n = 0; n < next; ++n) {
+                ext_data[n] = amrex::max(ext_data[n], ext_t[n]);
+            }
+        }
+    }
+
+#endif
+}
 
 #ifdef GRAVITY
 void
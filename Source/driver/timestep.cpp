@@ -459,6 +459,290 @@ Castro::estdt_burning (int is_new)
 }
 #endif
 
+Array<ValLocPair<Real, IntVect>, 3>
+Castro::estdt_fused (int is_new, bool hydro_limited, bool diffusion_limited, bool burning_limited)
+{
+
+    // Hydro (or MHD), diffusion, and burning limited timesteps,
+    // computed in a single sweep.  The zone's thermodynamic state
+    // comes from one (rho, e) EOS call that is shared by all of the
+    // limiters.  A limiter that is not active returns the largest
+    // representable value so that it never wins.
+
+    amrex::ignore_unused(diffusion_limited, burning_limited);
+
+    using dt_pair = ValLocPair<Real, IntVect>;
+
+    const Real inactive_dt = std::numeric_limits<Real>::max();
+
+    const auto dx = geom.CellSizeArray();
+
+    const MultiFab& stateMF = is_new ? get_new_data(State_Type) : get_old_data(State_Type);
+
+    auto const& ua = stateMF.const_arrays();
+
+#ifdef MHD
+    const MultiFab& bx = is_new ? get_new_data(Mag_Type_x) : get_old_data(Mag_Type_x);
+    const MultiFab& by = is_new ? get_new_data(Mag_Type_y) : get_old_data(Mag_Type_y);
+    const MultiFab& bz = is_new ? get_new_data(Mag_Type_z) : get_old_data(Mag_Type_z);
+
+    auto const& bxa = bx.const_arrays();
+    auto const& bya = by.const_arrays();
+    auto const& bza = bz.const_arrays();
+#endif
+
+#ifdef DIFFUSION
+    const Real ldiffuse_cutoff_density = diffuse_cutoff_density;
+    const Real lmax_dt = max_dt;
+    const Real lcfl = cfl;
+#endif
+
+    auto r = amrex::ParReduce(TypeList<ReduceOpMin, ReduceOpMin, ReduceOpMin>{},
+                              TypeList<dt_pair, dt_pair, dt_pair>{}, stateMF,
+    [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) -> GpuTuple<dt_pair, dt_pair, dt_pair>
+    {
+
+        Array4<Real const> const& u = ua[box_no];
+
+        IntVect idx(AMREX_D_DECL(i,j,k));
+
+        Real dt_hydro = inactive_dt;
+        Real dt_diffusion = inactive_dt;
+        Real dt_burning = inactive_dt;
+
+        Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+
+#ifdef DIFFUSION
+        eos_t eos_state;
+#else
+        eos_rep_t eos_state;
+#endif
+        eos_state.rho = u(i,j,k,URHO);
+        eos_state.T = u(i,j,k,UTEMP);
+        eos_state.e = u(i,j,k,UEINT) * rhoInv;
+        for (int n = 0; n < NumSpec; n++) {
+            eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+        }
+#if NAUX_NET > 0
+        for (int n = 0; n < NumAux; n++) {
+            eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+        }
+#endif
+
+        eos(eos_input_re, eos_state);
+
+        if (hydro_limited) {
+
+            Real ux = u(i,j,k,UMX) * rhoInv;
+            Real uy = u(i,j,k,UMY) * rhoInv;
+            Real uz = u(i,j,k,UMZ) * rhoInv;
+            amrex::ignore_unused(uy, uz);
+
+#ifdef MHD
+            Array4<Real const> const& bx_arr = bxa[box_no];
+            Array4<Real const> const& by_arr = bya[box_no];
+            Array4<Real const> const& bz_arr = bza[box_no];
+
+            Real bcx = 0.5_rt * (bx_arr(i+1,j,k) + bx_arr(i,j,k));
+            Real bcy = 0.5_rt * (by_arr(i,j+1,k) + by_arr(i,j,k));
+            Real bcz = 0.5_rt * (bz_arr(i,j,k+1) + bz_arr(i,j,k));
+
+            Real as = eos_state.gam1 * eos_state.p * rhoInv;
+            Real ca = (bcx*bcx + bcy*bcy + bcz*bcz) * rhoInv;
+
+            Real cx = 0.0_rt;
+            Real cy = 0.0_rt;
+            Real cz = 0.0_rt;
+
+            if (u(i,j,k,UEINT) * rhoInv > 0_rt) {
+                Real cad = bcx*bcx * rhoInv;
+                eos_soundspeed_mhd(cx, as, ca, cad);
+
+                cad = bcy*bcy * rhoInv;
+                eos_soundspeed_mhd(cy, as, ca, cad);
+
+                cad = bcz*bcz * rhoInv;
+                eos_soundspeed_mhd(cz, as, ca, cad);
+            }
+#else
+            Real cx = eos_state.cs;
+            Real cy = eos_state.cs;
+            Real cz = eos_state.cs;
+#endif
+            amrex::ignore_unused(cy, cz);
+
+            Real dt1 = dx[0]/(cx + std::abs(ux));
+
+            Real dt2;
+#if AMREX_SPACEDIM >= 2
+            dt2 = dx[1]/(cy + std::abs(uy));
+#else
+            dt2 = dt1;
+#endif
+
+            Real dt3;
+#if AMREX_SPACEDIM == 3
+            dt3 = dx[2]/(cz + std::abs(uz));
+#else
+            dt3 = dt1;
+#endif
+
+#ifdef MHD
+            dt_hydro = amrex::min(dt1, dt2, dt3);
+#else
+            // See estdt_cfl for the choice of the constraint.
+            if (castro::time_integration_method == 0 || castro::time_integration_method == 3) {
+                dt_hydro = amrex::min(dt1, dt2, dt3);
+            } else {
+                Real dt_tmp = 1.0_rt/dt1;
+#if AMREX_SPACEDIM >= 2
+                dt_tmp += 1.0_rt/dt2;
+#endif
+#if AMREX_SPACEDIM == 3
+                dt_tmp += 1.0_rt/dt3;
+#endif
+                dt_hydro = 1.0_rt/dt_tmp;
+            }
+#endif
+
+        }
+
+#ifdef DIFFUSION
+        if (diffusion_limited) {
+
+            if (u(i,j,k,URHO) > ldiffuse_cutoff_density) {
+
+                // we need the conductivity, which needs a copy of the
+                // state since it can modify it
+                eos_t cond_state = eos_state;
+                conductivity(cond_state);
+
+                Real D = cond_state.conductivity * rhoInv / cond_state.cv;
+
+                Real dt1 = 0.5_rt * dx[0]*dx[0] / D;
+
+                Real dt2;
+#if AMREX_SPACEDIM >= 2
+                dt2 = 0.5_rt * dx[1]*dx[1] / D;
+#else
+                dt2 = dt1;
+#endif
+
+                Real dt3;
+#if AMREX_SPACEDIM >= 3
+                dt3 = 0.5_rt * dx[2]*dx[2] / D;
+#else
+                dt3 = dt1;
+#endif
+
+                dt_diffusion = amrex::min(dt1, dt2, dt3);
+
+            } else {
+                dt_diffusion = lmax_dt/lcfl;
+            }
+        }
+#endif
+
+#ifdef REACTIONS
+        if (burning_limited) {
+
+            // See estdt_burning for a description of this limiter.
+
+            const Real derivative_floor = 1.e-50_rt;
+
+            dt_burning = 1.e200_rt;
+
+            Real rho = u(i,j,k,URHO);
+            Real T = u(i,j,k,UTEMP);
+
+            if (T >= castro::react_T_min && T <= castro::react_T_max &&
+                rho >= castro::react_rho_min && rho <= castro::react_rho_max) {
+
+                // The state above was made consistent with e, but the
+                // RHS has to be evaluated at the stored T, as in
+                // estdt_burning, so we do a separate (rho, T) EOS call.
+
+                burn_t burn_state;
+
+#if AMREX_SPACEDIM == 1
+                burn_state.dx = dx[0];
+#else
+                burn_state.dx = amrex::min(AMREX_D_DECL(dx[0], dx[1], dx[2]));
+#endif
+
+                burn_state.rho = rho;
+                burn_state.T   = T;
+                burn_state.e   = u(i,j,k,UEINT) * rhoInv;
+                for (int n = 0; n < NumSpec; ++n) {
+                    burn_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; ++n) {
+                    burn_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+                }
+#endif
+
+                Real e = burn_state.e;
+                Real X[NumSpec];
+                for (int n = 0; n < NumSpec; ++n) {
+                    X[n] = amrex::max(burn_state.xn[n], small_x);
+                }
+
+                eos(eos_input_rt, burn_state);
+
+                Array1D<Real, 1, neqs> ydot;
+                actual_rhs(burn_state, ydot);
+
+                Real dedt = ydot(net_ienuc);
+                Real dXdt[NumSpec];
+                for (int n = 0; n < NumSpec; ++n) {
+                    dXdt[n] = ydot(n+1) * aion[n];
+                }
+
+                dedt = amrex::max(std::abs(dedt), derivative_floor);
+
+                for (int n = 0; n < NumSpec; ++n) {
+                    if (X[n] >= castro::dtnuc_X_threshold) {
+                        dXdt[n] = amrex::max(std::abs(dXdt[n]), derivative_floor);
+                    } else {
+                        dXdt[n] = derivative_floor;
+                    }
+                }
+
+#ifdef NSE
+
+#ifdef SIMPLIFIED_SDC
+                for (int n = 0; n < NumSpec; ++n) {
+                    burn_state.y[SFS+n] = burn_state.rho * burn_state.xn[n];
+                }
+
+                burn_state.y[SEINT] = burn_state.rho * burn_state.e;
+#endif
+
+#ifdef NSE_NET
+                burn_state.mu_p = u(i,j,k,UMUP);
+                burn_state.mu_n = u(i,j,k,UMUN);
+#endif
+
+                if (!in_nse(burn_state)) {
+#endif
+                    dt_burning = dtnuc_e * e / dedt;
+#ifdef NSE
+                }
+#endif
+                for (int n = 0; n < NumSpec; ++n) {
+                    dt_burning = amrex::min(dt_burning, dtnuc_X * (X[n] / dXdt[n]));
+                }
+            }
+        }
+#endif
+
+        return {dt_pair{dt_hydro, idx}, dt_pair{dt_diffusion, idx}, dt_pair{dt_burning, idx}};
+    });
+
+    return {amrex::get<0>(r), amrex::get<1>(r), amrex::get<2>(r)};
+}
+
 #ifdef RADIATION
 Real
 Castro::estdt_rad (int is_new)
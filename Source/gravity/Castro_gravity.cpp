@@ -171,23 +171,30 @@ Castro::construct_new_gravity (Real time)
                 amrex::Print() << "\n... new-time composite Poisson gravity solve from level " << level << " to level " << parent->finestLevel() << std::endl << std::endl;
             }
 
-            // Use the "old" phi from the current time step as a guess for this solve.
+            // Start on the boundary conditions first, so that their
+            // communication overlaps the setup of the solve.
 
-            for (int lev = level; lev <= parent->finestLevel(); ++lev) {
-                MultiFab& lev_phi_old = getLevel(lev).get_old_data(PhiGrav_Type);
-                MultiFab& lev_phi_new = getLevel(lev).get_new_data(PhiGrav_Type);
+            gravity->start_phi_BCs(level, parent->finestLevel(), 1);
+
+            // Use the "old" phi from the current time step (or its
+            // extrapolation forward in time) as a guess for this solve.
 
-                MultiFab::Copy(lev_phi_new, lev_phi_old, 0, 0, 1, lev_phi_new.nGrow());
+            for (int lev = level; lev <= parent->finestLevel(); ++lev) {
+                gravity->fill_new_phi_guess(lev);
             }
 
             gravity->multilevel_solve_for_new_phi(level, parent->finestLevel());
         }
         else if (parent->subcyclingMode() != "None") {
-            // Use the "old" phi from the current time step as a guess for this solve.
+            // Start on the boundary conditions first, so that their
+            // communication overlaps the setup of the solve.
+
+            gravity->start_phi_BCs(level, level, 1);
 
-            MultiFab& phi_old = get_old_data(PhiGrav_Type);
+            // Use the "old" phi from the current time step (or its
+            // extrapolation forward in time) as a guess for this solve.
 
-            MultiFab::Copy(phi_new, phi_old, 0, 0, 1, phi_new.nGrow());
+            gravity->fill_new_phi_guess(level);
 
             // Subtract off the (composite - level) contribution for the purposes
             // of the level solve. We'll add it back later.
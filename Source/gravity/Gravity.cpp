@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 
 #ifdef _OPENMP
@@ -18,6 +20,7 @@
 #include <fundamental_constants.H>
 
 #include <Gravity_util.H>
+#include <gravity_tree.H>
 #include <MGutils.H>
 
 using namespace amrex;
@@ -71,6 +74,7 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _density)
     abs_tol(MAX_LEV),
     rel_tol(MAX_LEV),
     level_solver_resnorm(MAX_LEV),
+    phi_history(MAX_LEV),
     volume(MAX_LEV),
     area(MAX_LEV),
     phys_bc(_phys_bc)
@@ -82,6 +86,7 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _density)
 
      Density = _density;
      read_params();
+     read_point_masses();
      finest_level_allocated = -1;
 
      radial_grav_old.resize(MAX_LEV);
@@ -96,11 +101,21 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _density)
          make_mg_bc();
          init_multipole_grav();
      }
+     else if (gravity::gravity_type == "MultipoleGrav") {
+         init_multipole_grav();
+     }
      max_rhs = 0.0;
      numpts_at_level = -1;
 }
 
-Gravity::~Gravity() = default;
+Gravity::~Gravity()
+{
+    // Don't free the buffer of a reduction that is still in flight.
+
+    if (pending_bc_fill) {
+        wait_bc_reduction(*pending_bc_fill);
+    }
+}
 
 void
 Gravity::read_params ()
@@ -115,12 +130,19 @@ Gravity::read_params ()
 
         if ( (gravity::gravity_type != "ConstantGrav") &&
              (gravity::gravity_type != "PoissonGrav") &&
-             (gravity::gravity_type != "MonopoleGrav") )
+             (gravity::gravity_type != "MonopoleGrav") &&
+             (gravity::gravity_type != "MultipoleGrav") &&
+             (gravity::gravity_type != "PointMassGrav") )
              {
                 std::cout << "Sorry -- dont know this gravity type"  << std::endl;
-                amrex::Abort("Options are ConstantGrav, PoissonGrav, or MonopoleGrav");
+                amrex::Abort("Options are ConstantGrav, PoissonGrav, MonopoleGrav, MultipoleGrav, or PointMassGrav");
              }
 
+        if (gravity::gravity_type == "MultipoleGrav" && (AMREX_SPACEDIM != 3 || !dgeom.IsCartesian()))
+        {
+          amrex::Abort("MultipoleGrav is only implemented in 3D Cartesian coordinates");
+        }
+
         if (  gravity::gravity_type == "ConstantGrav")
         {
           if ( dgeom.IsSPHERICAL() ) {
@@ -153,6 +175,30 @@ Gravity::read_params ()
             amrex::Print() << "Warning: gravity::gravity_type = PoissonGrav assumes get_g_from_phi is true" << std::endl;
         }
 
+        if (gravity::phi_guess_order < 0 || gravity::phi_guess_order > 2) {
+            amrex::Abort("gravity.phi_guess_order must be 0, 1, or 2");
+        }
+
+        if (gravity::sync_interval < 1) {
+            amrex::Abort("gravity.sync_interval must be at least 1");
+        }
+
+        if (gravity::level0_solver != "MLMG" && gravity::level0_solver != "FFT") {
+            amrex::Abort("gravity.level0_solver must be MLMG or FFT");
+        }
+
+        if (gravity::level0_solver == "FFT") {
+#ifndef AMREX_USE_FFT
+            amrex::Abort("gravity.level0_solver = FFT needs AMReX built with USE_FFT = TRUE");
+#endif
+            if (gravity::gravity_type != "PoissonGrav") {
+                amrex::Abort("gravity.level0_solver = FFT is only used with gravity.gravity_type = PoissonGrav");
+            }
+            if (AMREX_SPACEDIM != 3 || !dgeom.IsCartesian() || dgeom.isAnyPeriodic()) {
+                amrex::Abort("gravity.level0_solver = FFT is only implemented in 3D Cartesian coordinates with no periodic boundaries");
+            }
+        }
+
         int nlevs = parent->maxLevel() + 1;
 
         // Allow run-time input of solver tolerance. If the user
@@ -281,6 +327,84 @@ Gravity::set_numpts_in_gravity (int numpts)
   numpts_at_level = numpts;
 }
 
+void
+Gravity::read_point_masses ()
+{
+    ParmParse pp("gravity");
+
+    const int n = pp.countval("point_mass_masses");
+
+    if (n == 0) {
+        return;
+    }
+
+    if (n > PointMassSet::max_point_masses) {
+        amrex::Abort("gravity.point_mass_masses: too many point masses");
+    }
+
+    Vector<Real> masses;
+    pp.getarr("point_mass_masses", masses, 0, n);
+
+    Vector<Real> loc[3];
+    const char* loc_names[3] = {"point_mass_x", "point_mass_y", "point_mass_z"};
+
+    for (int dir = 0; dir < 3; ++dir) {
+        if (dir < AMREX_SPACEDIM || pp.contains(loc_names[dir])) {
+            pp.getarr(loc_names[dir], loc[dir], 0, n);
+        } else {
+            loc[dir].resize(n, 0.0_rt);
+        }
+    }
+
+    // the softening length may be given once for all of the point masses
+
+    Vector<Real> softening(n, 0.0_rt);
+
+    const int n_soft = pp.countval("point_mass_softening");
+
+    if (n_soft == 1) {
+        Real eps;
+        pp.get("point_mass_softening", eps);
+        softening.assign(n, eps);
+    }
+    else if (n_soft == n) {
+        pp.getarr("point_mass_softening", softening, 0, n);
+    }
+    else if (n_soft != 0) {
+        amrex::Abort("gravity.point_mass_softening must have one value, or one for every point mass");
+    }
+
+    // In non-Cartesian coordinates the distance is only right for
+    // point masses on the axis (RZ) or at the origin (spherical).
+
+    if (!DefaultGeometry().IsCartesian()) {
+        for (int i = 0; i < n; ++i) {
+            if (loc[0][i] != 0.0_rt) {
+                amrex::Abort("gravity.point_mass_x must be 0 in non-Cartesian coordinates");
+            }
+        }
+    }
+
+    point_masses = PointMassSet{};
+
+    for (int i = 0; i < n; ++i) {
+        const Real x[3] = {loc[0][i], loc[1][i], loc[2][i]};
+        point_masses.add(masses[i], x, softening[i]);
+    }
+}
+
+void
+Gravity::set_point_masses (const PointMassSet& pm)
+{
+    point_masses = pm;
+}
+
+const PointMassSet&
+Gravity::get_point_masses () const
+{
+    return point_masses;
+}
+
 void
 Gravity::install_level (int                   level,
                         AmrLevel*             level_data,
@@ -299,6 +423,18 @@ Gravity::install_level (int                   level,
 
     level_solver_resnorm[level] = 0.0;
 
+    // The grids have changed, so the cached MLMG solvers and the
+    // history of phi on this level are stale.
+
+    mlmg_cache.clear();
+
+    phi_history[level].clear();
+
+    if (pending_bc_fill) {
+        wait_bc_reduction(*pending_bc_fill);
+        pending_bc_fill.reset();
+    }
+
     const Geometry& geom = level_data->Geom();
 
     if (gravity::gravity_type == "PoissonGrav") {
@@ -349,6 +485,13 @@ int Gravity::NoSync()
   return gravity::no_sync;
 }
 
+void
+Gravity::get_skipped_sync_mass (Real& mass, Real& abs_mass) const
+{
+    mass = skipped_sync_mass;
+    abs_mass = skipped_sync_abs_mass;
+}
+
 int Gravity::DoCompositeCorrection()
 {
   return gravity::do_composite_phi_correction;
@@ -385,6 +528,130 @@ Gravity::plus_grad_phi_curr(int level, Vector<std::unique_ptr<MultiFab> >& adden
     }
 }
 
+void
+Gravity::fill_new_phi_guess (int level)
+{
+    BL_PROFILE("Gravity::fill_new_phi_guess()");
+
+    const MultiFab& phi_old = LevelData[level]->get_old_data(PhiGrav_Type);
+    MultiFab& phi_new = LevelData[level]->get_new_data(PhiGrav_Type);
+
+    const Real t_old = LevelData[level]->get_state_data(PhiGrav_Type).prevTime();
+    const Real t_new = LevelData[level]->get_state_data(PhiGrav_Type).curTime();
+    const Real eps   = (t_new - t_old) * 1.e-6;
+
+    const int ng = phi_new.nGrow();
+
+    auto& history = phi_history[level];
+
+    // Forget anything that is not strictly earlier than the old time,
+    // e.g. if this step is a retry of one we already started.
+
+    history.erase(std::remove_if(history.begin(), history.end(),
+                                 [=] (const PhiHistory& h) { return h.time > t_old - eps; }),
+                  history.end());
+
+    const int order = amrex::min(gravity::phi_guess_order, static_cast<int>(history.size()));
+
+    if (order == 0 || eps <= 0.0) {
+
+        MultiFab::Copy(phi_new, phi_old, 0, 0, 1, ng);
+
+    }
+    else {
+
+        // Lagrange extrapolation to t_new through the old-time phi and
+        // the most recent order entries of the history.
+
+        Vector<Real> t(order + 1);
+        Vector<const MultiFab*> p(order + 1);
+
+        t[0] = t_old;
+        p[0] = &phi_old;
+
+        for (int n = 1; n <= order; ++n) {
+            const auto& h = history[history.size() - n];
+            t[n] = h.time;
+            p[n] = h.phi.get();
+        }
+
+        phi_new.setVal(0.0, 0, 1, ng);
+
+        for (int n = 0; n <= order; ++n) {
+            Real w = 1.0_rt;
+            for (int m = 0; m <= order; ++m) {
+                if (m != n) {
+                    w *= (t_new - t[m]) / (t[n] - t[m]);
+                }
+            }
+            MultiFab::Saxpy(phi_new, w, *p[n], 0, 0, 1, ng);
+        }
+
+        if (gravity::verbose > 1) {
+            amrex::Print() << " ... extrapolated the initial guess for phi at level " << level
+                           << " with order " << order << std::endl;
+        }
+
+    }
+
+    // Save the old-time phi for the next steps.
+
+    if (gravity::phi_guess_order > 0) {
+
+        while (static_cast<int>(history.size()) >= gravity::phi_guess_order) {
+            history.erase(history.begin());
+        }
+
+        PhiHistory h;
+        h.time = t_old;
+        h.phi = std::make_unique<MultiFab>(phi_old.boxArray(), phi_old.DistributionMap(), 1, phi_old.nGrow());
+        MultiFab::Copy(*h.phi, phi_old, 0, 0, 1, phi_old.nGrow());
+
+        history.push_back(std::move(h));
+
+    }
+}
+
+void
+Gravity::start_phi_BCs (int crse_level, int fine_level, int is_new)
+{
+    BL_PROFILE("Gravity::start_phi_BCs()");
+
+    // Anything left over from an earlier start that was never used
+    // is stale now.
+
+    if (pending_bc_fill) {
+        wait_bc_reduction(*pending_bc_fill);
+        pending_bc_fill.reset();
+    }
+
+    // The boundary conditions are only built for solves that start
+    // from the coarse level on a domain that is not periodic.
+
+    if (gravity::async_bc_fill == 0 ||
+        gravity::gravity_type != "PoissonGrav" ||
+        crse_level != 0 ||
+        use_fft_solve(crse_level, fine_level) ||
+        crse_level > gravity::max_solve_level ||
+        parent->Geom(crse_level).isAllPeriodic()) {
+        return;
+    }
+
+    fine_level = amrex::min(fine_level, gravity::max_solve_level);
+
+    const auto& rhs = get_rhs(crse_level, fine_level - crse_level + 1, is_new);
+
+#if (AMREX_SPACEDIM == 3)
+    if (gravity::direct_sum_bcs) {
+        pending_bc_fill = start_direct_sum_BCs(crse_level, fine_level, amrex::GetVecOfPtrs(rhs));
+    } else {
+        pending_bc_fill = start_multipole_BCs(crse_level, fine_level, amrex::GetVecOfPtrs(rhs));
+    }
+#else
+    pending_bc_fill = start_multipole_BCs(crse_level, fine_level, amrex::GetVecOfPtrs(rhs));
+#endif
+}
+
 void
 Gravity::swapTimeLevels (int level)
 {
@@ -485,15 +752,60 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
     }
 
     BL_ASSERT(parent->finestLevel()>crse_level);
+
+    const Geometry& crse_geom = parent->Geom(crse_level);
+    const Box& crse_domain = crse_geom.Domain();
+
+    // Only do the sync every gravity.sync_interval steps of the coarse
+    // level. The sync is a correction to the new-time phi only, and
+    // the next new-time solve sees the refluxed density anyway, so
+    // what we skip is not carried over to the next sync. We do keep
+    // track of the mass in the RHS of the skipped syncs (drho, plus
+    // the mismatch in the flux of grad phi) for the diagnostics. drho
+    // and dphi have been averaged down, so the coarse level holds all
+    // of it.
+
+    if (gravity::sync_interval > 1 && parent->levelSteps(crse_level) % gravity::sync_interval != 0) {
+
+        MultiFab skipped(grids[crse_level], dmap[crse_level], 1, 0);
+        MultiFab::Copy(skipped, *dphi[0], 0, 0, 1, 0);
+        skipped.mult(1.0 / Ggravity);
+        MultiFab::Add(skipped, *drho[0], 0, 0, 1, 0);
+
+        const Real mass = MultiFab::Dot(skipped, 0, *volume[crse_level], 0, 1, 0);
+        skipped.abs(0, 1);
+        const Real abs_mass = MultiFab::Dot(skipped, 0, *volume[crse_level], 0, 1, 0);
+
+        skipped_sync_mass += mass;
+        skipped_sync_abs_mass += abs_mass;
+
+        if (gravity::verbose > 1) {
+            amrex::Print() << " ... skipping gravity_sync at crse_level " << crse_level
+                           << " (sync RHS mass " << mass << ", |mass| " << abs_mass << ")" << std::endl;
+        }
+
+        return;
+    }
+
+    // Optionally do the solve on only the coarsest
+    // gravity.sync_solve_levels levels, and interpolate the correction
+    // onto the finer ones.
+
+    int solve_level = fine_level;
+    if (gravity::sync_solve_levels > 0) {
+        solve_level = amrex::min(fine_level, crse_level + gravity::sync_solve_levels - 1);
+    }
+
     if (gravity::verbose > 1 && ParallelDescriptor::IOProcessor()) {
           std::cout << " ... gravity_sync at crse_level " << crse_level << '\n';
           std::cout << " ...     up to finest_level     " << fine_level << '\n';
+          if (solve_level < fine_level) {
+              std::cout << " ...     solving up to level    " << solve_level << '\n';
+          }
     }
 
-    const Geometry& crse_geom = parent->Geom(crse_level);
-    const Box& crse_domain = crse_geom.Domain();
-
     int nlevs = fine_level - crse_level + 1;
+    int nsolve = solve_level - crse_level + 1;
 
     // Construct delta(phi) and delta(grad_phi). delta(phi)
     // needs a ghost zone for holding the boundary condition
@@ -527,9 +839,9 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
     // We will temporarily leave the RHS divided by (4 * pi * G) because that
     // is the form expected by the boundary condition routine.
 
-    Vector<std::unique_ptr<MultiFab> > rhs(nlevs);
+    Vector<std::unique_ptr<MultiFab> > rhs(nsolve);
 
-    for (int lev = crse_level; lev <= fine_level; ++lev) {
+    for (int lev = crse_level; lev <= solve_level; ++lev) {
         rhs[lev - crse_level] = std::make_unique<MultiFab>(LevelData[lev]->boxArray(), LevelData[lev]->DistributionMap(), 1, 0);
         MultiFab::Copy(*rhs[lev - crse_level], *dphi[lev - crse_level], 0, 0, 1, 0);
         rhs[lev - crse_level]->mult(1.0 / Ggravity);
@@ -546,20 +858,20 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
 
 #if (AMREX_SPACEDIM == 3)
       if ( gravity::direct_sum_bcs )
-          fill_direct_sum_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+          fill_direct_sum_BCs(crse_level,solve_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
       else {
-          fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+          fill_multipole_BCs(crse_level,solve_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
       }
 #elif (AMREX_SPACEDIM == 2)
-      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+      fill_multipole_BCs(crse_level,solve_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
 #else
-      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+      fill_multipole_BCs(crse_level,solve_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
 #endif
 
     }
 
     // Restore the factor of (4 * pi * G) for the Poisson solve.
-    for (int lev = crse_level; lev <= fine_level; ++lev)
+    for (int lev = crse_level; lev <= solve_level; ++lev)
         rhs[lev - crse_level]->mult(Ggravity);
 
     // In the all-periodic case we enforce that the RHS sums to zero.
@@ -583,17 +895,23 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
             amrex::Print() << "WARNING: Adjusting RHS in gravity_sync solve by " << local_correction << '\n';
         }
 
-        for (int lev = fine_level; lev >= crse_level; --lev) {
+        for (int lev = solve_level; lev >= crse_level; --lev) {
             rhs[lev-crse_level]->plus(-local_correction, 0, 1, 0);
         }
     }
 
     // Do multi-level solve for delta_phi.
 
-    solve_for_delta_phi(crse_level, fine_level,
+    auto delta_phi_p = amrex::GetVecOfPtrs(delta_phi);
+    auto ec_gdPhi_p = amrex::GetVecOfVecOfPtrs(ec_gdPhi);
+
+    delta_phi_p.resize(nsolve);
+    ec_gdPhi_p.resize(nsolve);
+
+    solve_for_delta_phi(crse_level, solve_level,
                         amrex::GetVecOfPtrs(rhs),
-                        amrex::GetVecOfPtrs(delta_phi),
-                        amrex::GetVecOfVecOfPtrs(ec_gdPhi));
+                        delta_phi_p,
+                        ec_gdPhi_p);
 
     // In the all-periodic case we enforce that delta_phi averages to zero.
 
@@ -601,12 +919,46 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
 
         Real local_correction = delta_phi[0]->sum() / static_cast<Real>(grids[crse_level].numPts());
 
-        for (int lev = crse_level; lev <= fine_level; ++lev) {
+        for (int lev = crse_level; lev <= solve_level; ++lev) {
             delta_phi[lev - crse_level]->plus(-local_correction, 0, 1, 1);
         }
 
     }
 
+    // Interpolate the correction onto the levels we did not solve on,
+    // from the coarsest upwards. These levels do not touch the
+    // physical boundary, so we do not need a physical BC function.
+
+    for (int lev = solve_level + 1; lev <= fine_level; ++lev) {
+
+        const Real time = LevelData[lev]->get_state_data(PhiGrav_Type).curTime();
+
+        GradPhiPhysBCFunct phys_bc_noop;
+
+        MultiFab delta_phi_fine(grids[lev], dmap[lev], 1, 0);
+
+        const Vector<BCRec>& phi_bcs = LevelData[lev]->get_desc_lst()[PhiGrav_Type].getBCs();
+
+        amrex::InterpFromCoarseLevel(delta_phi_fine, time, *delta_phi[lev - 1 - crse_level],
+                                     0, 0, 1,
+                                     parent->Geom(lev-1), parent->Geom(lev),
+                                     phys_bc_noop, 0, phys_bc_noop, 0, parent->refRatio(lev-1),
+                                     &pc_interp, phi_bcs, 0);
+
+        MultiFab::Copy(*delta_phi[lev - crse_level], delta_phi_fine, 0, 0, 1, 0);
+
+        const Vector<BCRec>& gp_bcs = LevelData[lev]->get_desc_lst()[Gravity_Type].getBCs();
+
+        for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+            amrex::InterpFromCoarseLevel(*ec_gdPhi[lev - crse_level][n], time, *ec_gdPhi[lev - 1 - crse_level][n],
+                                         0, 0, 1,
+                                         parent->Geom(lev-1), parent->Geom(lev),
+                                         phys_bc_noop, 0, phys_bc_noop, 0, parent->refRatio(lev-1),
+                                         &face_linear_interp, gp_bcs, 0);
+        }
+
+    }
+
     // Add delta_phi to phi_new, and grad(delta_phi) to grad(delta_phi_curr) on each level.
     // Update the cell-centered gravity too.
 
@@ -891,12 +1243,24 @@ Gravity::get_old_grav_vector(int level, MultiFab& grav_vector, Real time)
        make_radial_gravity(level,prev_time,radial_grav_old[level]);
        interpolate_monopole_grav(level,radial_grav_old[level],grav);
 
+#if (AMREX_SPACEDIM == 3)
+    } else if (gravity::gravity_type == "MultipoleGrav") {
+
+       const Real prev_time = LevelData[level]->get_state_data(State_Type).prevTime();
+       MultiFab& phi = LevelData[level]->get_old_data(PhiGrav_Type);
+       make_multipole_gravity(level,prev_time,phi,grav);
+#endif
+
     } else if (gravity::gravity_type == "PoissonGrav") {
 
        const Geometry& geom = parent->Geom(level);
        amrex::average_face_to_cellcenter(grav, amrex::GetVecOfConstPtrs(grad_phi_prev[level]), geom);
        grav.mult(-1.0, ng); // g = - grad(phi)
 
+    } else if (gravity::gravity_type == "PointMassGrav") {
+
+       // Only the point masses, which are added below.
+
     } else {
        amrex::Abort("Unknown gravity_type in get_old_grav_vector");
     }
@@ -912,7 +1276,7 @@ Gravity::get_old_grav_vector(int level, MultiFab& grav_vector, Real time)
     }
 
 #if (AMREX_SPACEDIM > 1)
-    if (gravity::gravity_type != "ConstantGrav") {
+    if (gravity::gravity_type != "ConstantGrav" && gravity::gravity_type != "PointMassGrav") {
         // Fill ghost cells
         AmrLevel* amrlev = &parent->getLevel(level) ;
         AmrLevel::FillPatch(*amrlev,grav_vector,ng,time,Gravity_Type,0,AMREX_SPACEDIM);
@@ -924,6 +1288,11 @@ Gravity::get_old_grav_vector(int level, MultiFab& grav_vector, Real time)
         MultiFab& phi = LevelData[level]->get_old_data(PhiGrav_Type);
         add_pointmass_to_gravity(level,phi,grav_vector);
     }
+
+    if (point_masses.n > 0) {
+        MultiFab& phi = LevelData[level]->get_old_data(PhiGrav_Type);
+        add_point_masses_to_gravity(level,phi,grav_vector);
+    }
 }
 
 void
@@ -963,12 +1332,24 @@ Gravity::get_new_grav_vector(int level, MultiFab& grav_vector, Real time)
         make_radial_gravity(level,cur_time,radial_grav_new[level]);
         interpolate_monopole_grav(level,radial_grav_new[level],grav);
 
+#if (AMREX_SPACEDIM == 3)
+    } else if (gravity::gravity_type == "MultipoleGrav") {
+
+        const Real cur_time = LevelData[level]->get_state_data(State_Type).curTime();
+        MultiFab& phi = LevelData[level]->get_new_data(PhiGrav_Type);
+        make_multipole_gravity(level,cur_time,phi,grav);
+#endif
+
     } else if (gravity::gravity_type == "PoissonGrav") {
 
         const Geometry& geom = parent->Geom(level);
         amrex::average_face_to_cellcenter(grav, amrex::GetVecOfConstPtrs(grad_phi_curr[level]), geom);
         grav.mult(-1.0, ng); // g = - grad(phi)
 
+    } else if (gravity::gravity_type == "PointMassGrav") {
+
+       // Only the point masses, which are added below.
+
     } else {
        amrex::Abort("Unknown gravity_type in get_new_grav_vector");
     }
@@ -984,7 +1365,7 @@ Gravity::get_new_grav_vector(int level, MultiFab& grav_vector, Real time)
     }
 
 #if (AMREX_SPACEDIM > 1)
-    if (gravity::gravity_type != "ConstantGrav" && ng>0) {
+    if (gravity::gravity_type != "ConstantGrav" && gravity::gravity_type != "PointMassGrav" && ng>0) {
         // Fill ghost cells
         AmrLevel* amrlev = &parent->getLevel(level) ;
         AmrLevel::FillPatch(*amrlev,grav_vector,ng,time,Gravity_Type,0,AMREX_SPACEDIM);
@@ -996,6 +1377,11 @@ Gravity::get_new_grav_vector(int level, MultiFab& grav_vector, Real time)
         MultiFab& phi = LevelData[level]->get_new_data(PhiGrav_Type);
         add_pointmass_to_gravity(level,phi,grav_vector);
     }
+
+    if (point_masses.n > 0) {
+        MultiFab& phi = LevelData[level]->get_new_data(PhiGrav_Type);
+        add_point_masses_to_gravity(level,phi,grav_vector);
+    }
 }
 
 void
@@ -1426,72 +1812,394 @@ Gravity::interpolate_monopole_grav(int level, RealVector& radial_grav, MultiFab&
     }
 }
 
+#if (AMREX_SPACEDIM == 3)
 void
-Gravity::compute_radial_mass(const Box& bx,
-                             Array4<Real const> const u,
-                             RealVector& radial_mass_local,
-                             RealVector& radial_vol_local,
-#ifdef GR_GRAV
-                             RealVector& radial_pres_local,
-#endif
-                             int n1d, int level) const
+Gravity::make_multipole_gravity(int level, Real time, MultiFab& phi, MultiFab& grav_vector)
 {
-    const Geometry& geom = parent->Geom(level);
+    BL_PROFILE("Gravity::make_multipole_gravity()");
 
-    GpuArray<Real, 3> dx, problo;
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-        dx[i] = geom.CellSizeArray()[i];
-        problo[i] = geom.ProbLoArray()[i];
-    }
-    for (int i = AMREX_SPACEDIM; i < 3; ++i) {
-        dx[i] = 0.0_rt;
-        problo[i] = 0.0_rt;
-    }
+    BL_ASSERT(gravity::lnum >= 0);
 
-    Real dr = dx[0] / static_cast<Real>(gravity::drdxfac);
-    Real drinv = 1.0_rt / dr;
+    const Real strt = ParallelDescriptor::second();
 
-    const int coord_type = geom.Coord();
+    // We bin the mass in radial shells about the center, of width
+    // dx / drdxfac on the coarse level.  For every bin we need the
+    // moments of the mass interior to it (qL, which fall off as
+    // r^{-l-1}) and exterior to it (qU, which grow as r^l).  The images
+    // of the mass behind symmetric boundaries can lie farther from the
+    // center than the domain corners, so we make room for those too.
 
-    AMREX_ALWAYS_ASSERT(coord_type >= 0 && coord_type <= 2);
+    const Real drInv = gravity::drdxfac * multipole::rmax / parent->Geom(0).CellSize(0);
+    const int nbins = static_cast<int>(3.0_rt * drInv) + 1;
 
-    Real octant_factor = 1.0_rt;
+    const int lnum = gravity::lnum;
 
-    if (coord_type == 0) {
+    Box boxq0( IntVect(AMREX_D_DECL(0, 0, 0)), IntVect(AMREX_D_DECL(lnum, 0,    nbins-1)) );
+    Box boxqC( IntVect(AMREX_D_DECL(0, 0, 0)), IntVect(AMREX_D_DECL(lnum, lnum, nbins-1)) );
 
-        if ((std::abs(problem::center[0] - problo[0]) < 1.e-2_rt * dx[0]) &&
-            (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) &&
-            (std::abs(problem::center[2] - problo[2]) < 1.e-2_rt * dx[2])) {
+    // The moments, in the order qL0, qLC, qLS, qU0, qUC, qUS
 
-            octant_factor = 8.0_rt;
+    const int nq = 6;
 
-        }
+    auto q_box = [&] (int n) -> const Box& { return (n % 3 == 0) ? boxq0 : boxqC; };
 
-    } else if (coord_type == 1) {
+    Vector<FArrayBox> q(nq);
+    for (int n = 0; n < nq; ++n) {
+        q[n].resize(q_box(n), 1);
+        q[n].setVal<RunOn::Device>(0.0);
+    }
 
-        if (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) {
+    for (int lev = 0; lev <= level; ++lev)
+    {
+        // Get the density at this time, masking out the zones covered
+        // by the next finer level.
 
-            octant_factor = 2.0_rt;
+        const Real t_old = LevelData[lev]->get_state_data(State_Type).prevTime();
+        const Real t_new = LevelData[lev]->get_state_data(State_Type).curTime();
+        const Real eps   = (t_new - t_old) * 1.e-6;
 
-        }
+        MultiFab rho(grids[lev], dmap[lev], 1, 0);
 
-    }
+        if (eps == 0.0 || std::abs(time - t_new) < eps) {
+            MultiFab::Copy(rho, LevelData[lev]->get_new_data(State_Type), URHO, 0, 1, 0);
+        }
+        else if (std::abs(time - t_old) < eps) {
+            MultiFab::Copy(rho, LevelData[lev]->get_old_data(State_Type), URHO, 0, 1, 0);
+        }
+        else if (time > t_old && time < t_new) {
+            const Real alpha = (time - t_old) / (t_new - t_old);
+            MultiFab::LinComb(rho,
+                              1.0_rt - alpha, LevelData[lev]->get_old_data(State_Type), URHO,
+                              alpha, LevelData[lev]->get_new_data(State_Type), URHO,
+                              0, 1, 0);
+        }
+        else {
+            std::cout << " Level / Time in make_multipole_gravity is: " << lev << " " << time  << std::endl;
+            std::cout << " but old / new time      are: " << t_old << " " << t_new << std::endl;
+            amrex::Abort("Problem in Gravity::make_multipole_gravity");
+        }
 
-    Real fac = static_cast<Real>(gravity::drdxfac);
+        if (lev < level) {
+            auto* fine_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
+            if (fine_level != nullptr) {
+                const MultiFab& mask = fine_level->build_fine_mask();
+                MultiFab::Multiply(rho, mask, 0, 0, 1, 0);
+            } else {
+                amrex::Abort("unable to create mask");
+            }
+        }
 
-    Real dx_frac = dx[0] / fac;
-    Real dy_frac = dx[1] / fac;
-    Real dz_frac = dx[2] / fac;
+        const auto dx = parent->Geom(lev).CellSizeArray();
+        const auto problo = parent->Geom(lev).ProbLoArray();
 
-    Real* const radial_mass_ptr = radial_mass_local.dataPtr();
-    Real* const radial_vol_ptr = radial_vol_local.dataPtr();
-#ifdef GR_GRAV
-    Real* const radial_pres_ptr = radial_pres_local.dataPtr();
+#ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        Vector<Vector<FArrayBox>> priv_q(nthreads);
+        for (int i = 0; i < nthreads; i++) {
+            priv_q[i].resize(nq);
+            for (int n = 0; n < nq; ++n) {
+                priv_q[i][n].resize(q_box(n), 1);
+            }
+        }
+#pragma omp parallel
 #endif
-
-    amrex::ParallelFor(bx,
+        {
+#ifdef _OPENMP
+            int tid = omp_get_thread_num();
+            Vector<FArrayBox>& my_q = priv_q[tid];
+            for (int n = 0; n < nq; ++n) {
+                my_q[n].setVal<RunOn::Device>(0.0);
+            }
+#else
+            Vector<FArrayBox>& my_q = q;
+#endif
+
+            auto qL0_arr = my_q[0].array();
+            auto qLC_arr = my_q[1].array();
+            auto qLS_arr = my_q[2].array();
+            auto qU0_arr = my_q[3].array();
+            auto qUC_arr = my_q[4].array();
+            auto qUS_arr = my_q[5].array();
+
+            for (MFIter mfi(rho, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+
+                auto rho_arr = rho[mfi].array();
+                auto vol = (*volume[lev])[mfi].array();
+
+                amrex::ParallelFor(amrex::Gpu::KernelInfo().setReduction(true), bx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::Gpu::Handler const& handler) noexcept
+                {
+                    const Real rmax_cubed_inv = 1.0_rt / (multipole::rmax * multipole::rmax * multipole::rmax);
+
+                    GpuArray<Real, 3> loc;
+                    const int idx[3] = {i, j, k};
+                    for (int n = 0; n < 3; ++n) {
+                        loc[n] = (problo[n] + (static_cast<Real>(idx[n]) + 0.5_rt) * dx[n] - problem::center[n]) / multipole::rmax;
+                    }
+
+                    const Real dV = vol(i,j,k) * rmax_cubed_inv;
+
+                    // the zone itself, and then its images behind any
+                    // symmetric lower boundaries
+
+                    for (int image = 0; image < 8; ++image) {
+
+                        GpuArray<Real, 3> x = loc;
+                        bool valid = true;
+
+                        for (int n = 0; n < 3; ++n) {
+                            if (image & (1 << n)) {
+                                if (multipole::doSymmetricAddLo(n)) {
+                                    x[n] = (2.0_rt * (problo[n] - problem::center[n])) / multipole::rmax - loc[n];
+                                } else {
+                                    valid = false;
+                                }
+                            }
+                        }
+
+                        if (!valid) {
+                            continue;
+                        }
+
+                        const Real r = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+                        const int bin = amrex::min(static_cast<int>(r * drInv), nbins - 1);
+
+                        const Real cosTheta = r > 0.0_rt ? x[2] / r : 1.0_rt;
+                        const Real phiAngle = std::atan2(x[1], x[0]);
+
+                        multipole_add_binned(cosTheta, phiAngle, r, rho_arr(i,j,k), dV,
+                                             qL0_arr, qLC_arr, qLS_arr, qU0_arr, qUC_arr, qUS_arr,
+                                             bin, handler, image == 0);
+                    }
+                });
+            }
+
+#ifdef _OPENMP
+#pragma omp barrier
+            for (int n = 0; n < nq; ++n) {
+                const int np = static_cast<int>(q_box(n).numPts());
+                Real* p = q[n].dataPtr();
+#pragma omp for
+                for (int i = 0; i < np; ++i) {
+                    for (int it = 0; it < nthreads; it++) {
+                        p[i] += priv_q[it][n].dataPtr()[i];
+                    }
+                }
+            }
+#endif
+        }
+
+    } // end loop over levels
+
+    // Add up the binned moments over all processes, and then sum them
+    // over the bins: qL for bin b holds the mass in bins <= b, and qU
+    // the mass in bins > b.
+
+    for (int n = 0; n < nq; ++n) {
+
+        const Box& bx = q_box(n);
+
+        FArrayBox q_host(bx, 1, The_Pinned_Arena());
+        q_host.copy<RunOn::Device>(q[n], bx);
+        Gpu::streamSynchronize();
+
+        ParallelDescriptor::ReduceRealSum(q_host.dataPtr(), static_cast<int>(bx.numPts()));
+
+        auto qh = q_host.array();
+
+        for (int m = 0; m <= bx.bigEnd(1); ++m) {
+            for (int l = 0; l <= lnum; ++l) {
+                if (n < 3) {
+                    for (int b = 1; b < nbins; ++b) {
+                        qh(l,m,b) += qh(l,m,b-1);
+                    }
+                }
+                else {
+                    Real outer = 0.0_rt;
+                    for (int b = nbins - 1; b >= 0; --b) {
+                        const Real this_bin = qh(l,m,b);
+                        qh(l,m,b) = outer;
+                        outer += this_bin;
+                    }
+                }
+            }
+        }
+
+        q[n].copy<RunOn::Device>(q_host, bx);
+        Gpu::streamSynchronize();
+    }
+
+    // Now evaluate phi and g = -grad phi from the moments of the bin
+    // that each zone (including ghost zones) falls in.
+
+    const auto dx = parent->Geom(level).CellSizeArray();
+    const auto problo = parent->Geom(level).ProbLoArray();
+
+    const int ng_phi = phi.nGrow();
+    const int ng_grav = grav_vector.nGrow();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(grav_vector, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& phi_bx = mfi.growntilebox(ng_phi);
+        const Box& grav_bx = mfi.growntilebox(ng_grav);
+        const Box bx = amrex::grow(mfi.tilebox(), amrex::max(ng_phi, ng_grav));
+
+        auto qL0_arr = q[0].const_array();
+        auto qLC_arr = q[1].const_array();
+        auto qLS_arr = q[2].const_array();
+        auto qU0_arr = q[3].const_array();
+        auto qUC_arr = q[4].const_array();
+        auto qUS_arr = q[5].const_array();
+
+        auto phi_arr = phi[mfi].array();
+        auto g = grav_vector[mfi].array();
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const Real x = (problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0]) / multipole::rmax;
+            const Real y = (problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1]) / multipole::rmax;
+            const Real z = (problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2]) / multipole::rmax;
+
+            const Real r = std::sqrt(x * x + y * y + z * z);
+            const int bin = amrex::min(static_cast<int>(r * drInv), nbins - 1);
+
+            Real phi_zone;
+            GpuArray<Real, 3> grad;
+
+            multipole_phi_and_grad(x, y, z, bin,
+                                   qL0_arr, qLC_arr, qLS_arr, qU0_arr, qUC_arr, qUS_arr,
+                                   phi_zone, grad);
+
+            // Undo the scaling of the distances and volumes by rmax.
+
+            const IntVect iv(AMREX_D_DECL(i, j, k));
+
+            if (phi_bx.contains(iv)) {
+                phi_arr(i,j,k) = -C::Gconst * phi_zone * multipole::rmax * multipole::rmax;
+            }
+
+            if (grav_bx.contains(iv)) {
+                for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                    g(i,j,k,n) = C::Gconst * grad[n] * multipole::rmax;
+                }
+            }
+        });
+    }
+
+    if (gravity::verbose)
+    {
+        const int IOProc = ParallelDescriptor::IOProcessorNumber();
+        Real      end    = ParallelDescriptor::second() - strt;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(end,IOProc);
+        amrex::Print() << "Gravity::make_multipole_gravity() time = " << end << std::endl << std::endl;
+#ifdef BL_LAZY
+        });
+#endif
+    }
+}
+#endif
+
+void
+Gravity::compute_radial_mass(const Box& bx,
+                             Array4<Real const> const& u_old,
+                             Array4<Real const> const& u_new,
+                             Real a_old, Real a_new,
+                             Array4<Real const> const& mask,
+                             RealVector& radial_mass_local,
+                             RealVector& radial_vol_local,
+#ifdef GR_GRAV
+                             RealVector& radial_pres_local,
+#endif
+                             int n1d, int level) const
+{
+    const Geometry& geom = parent->Geom(level);
+
+    GpuArray<Real, 3> dx, problo;
+    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+        dx[i] = geom.CellSizeArray()[i];
+        problo[i] = geom.ProbLoArray()[i];
+    }
+    for (int i = AMREX_SPACEDIM; i < 3; ++i) {
+        dx[i] = 0.0_rt;
+        problo[i] = 0.0_rt;
+    }
+
+    Real dr = dx[0] / static_cast<Real>(gravity::drdxfac);
+    Real drinv = 1.0_rt / dr;
+
+    const int coord_type = geom.Coord();
+
+    AMREX_ALWAYS_ASSERT(coord_type >= 0 && coord_type <= 2);
+
+    Real octant_factor = 1.0_rt;
+
+    if (coord_type == 0) {
+
+        if ((std::abs(problem::center[0] - problo[0]) < 1.e-2_rt * dx[0]) &&
+            (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) &&
+            (std::abs(problem::center[2] - problo[2]) < 1.e-2_rt * dx[2])) {
+
+            octant_factor = 8.0_rt;
+
+        }
+
+    } else if (coord_type == 1) {
+
+        if (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) {
+
+            octant_factor = 2.0_rt;
+
+        }
+
+    }
+
+    Real fac = static_cast<Real>(gravity::drdxfac);
+
+    Real dx_frac = dx[0] / fac;
+    Real dy_frac = dx[1] / fac;
+    Real dz_frac = dx[2] / fac;
+
+    Real* const radial_mass_ptr = radial_mass_local.dataPtr();
+    Real* const radial_vol_ptr = radial_vol_local.dataPtr();
+#ifdef GR_GRAV
+    Real* const radial_pres_ptr = radial_pres_local.dataPtr();
+#endif
+
+    const bool use_mask = mask.dataPtr() != nullptr;
+
+    amrex::ParallelFor(bx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
+        // The time-interpolated, masked state.  We skip the old (new)
+        // data entirely when its weight is zero, so that we never
+        // touch data that has not been set yet.
+
+        const Real msk = use_mask ? mask(i,j,k) : 1.0_rt;
+
+        auto u = [=] (int n) -> Real
+        {
+            Real s = 0.0_rt;
+            if (a_old != 0.0_rt) {
+                s += a_old * u_old(i,j,k,n);
+            }
+            if (a_new != 0.0_rt) {
+                s += a_new * u_new(i,j,k,n);
+            }
+            return s * msk;
+        };
+
+        const Real rho = u(URHO);
+
         Real xc = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0];
         Real lo_i = problo[0] + static_cast<Real>(i) * dx[0] - problem::center[0];
 
@@ -1509,24 +2217,24 @@ Gravity::compute_radial_mass(const Box& bx,
         // this case, so we'll skip these masked out zones (which will have rho
         // exactly equal to zero).
 
-        if (u(i,j,k,URHO) == 0.0_rt) {
+        if (rho == 0.0_rt) {
             return;
         }
 
 #ifdef GR_GRAV
-        Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+        Real rhoInv = 1.0_rt / rho;
 
         eos_t eos_state;
 
-        eos_state.rho = u(i,j,k,URHO);
-        eos_state.e   = u(i,j,k,UEINT) * rhoInv;
-        eos_state.T   = u(i,j,k,UTEMP);
+        eos_state.rho = rho;
+        eos_state.e   = u(UEINT) * rhoInv;
+        eos_state.T   = u(UTEMP);
         for (int n = 0; n < NumSpec; ++n) {
-            eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+            eos_state.xn[n] = u(UFS+n) * rhoInv;
         }
 #if NAUX_NET > 0
         for (int n = 0; n < NumAux; ++n) {
-            eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+            eos_state.aux[n] = u(UFX+n) * rhoInv;
         }
 #endif
 
@@ -1582,7 +2290,7 @@ Gravity::compute_radial_mass(const Box& bx,
                         }
 
                         if (index <= n1d - 1) {
-                            Gpu::Atomic::Add(&radial_mass_ptr[index], vol_frac * u(i,j,k,URHO));
+                            Gpu::Atomic::Add(&radial_mass_ptr[index], vol_frac * rho);
                             Gpu::Atomic::Add(&radial_vol_ptr[index], vol_frac);
 #ifdef GR_GRAV
                             Gpu::Atomic::Add(&radial_pres_ptr[index], vol_frac * eos_state.p);
@@ -1766,11 +2474,107 @@ Gravity::init_multipole_grav() const
     multipole::rmax = 0.5_rt * maxWidth * std::sqrt(static_cast<Real>(AMREX_SPACEDIM));
 }
 
+void
+Gravity::start_bc_reduction (PendingBCFill& bcs)
+{
+    BL_PROFILE("Gravity::start_bc_reduction()");
+
+    Long n = 0;
+    for (const auto& fab : bcs.fabs) {
+        n += fab.size();
+    }
+
+    // because the number of elements in mpi_reduce is int
+    BL_ASSERT(n <= std::numeric_limits<int>::max());
+
+    bcs.buffer.resize(n);
+
+    // Pack everything into one host buffer so that there is a single
+    // reduction to wait on.
+
+    Gpu::streamSynchronize();
+
+    Real* buf = bcs.buffer.data();
+
+    for (const auto& fab : bcs.fabs) {
+        if (fab.arena()->isHostAccessible()) {
+            std::memcpy(buf, fab.dataPtr(), fab.size() * sizeof(Real));
+        } else {
+            Gpu::dtoh_memcpy_async(buf, fab.dataPtr(), fab.size() * sizeof(Real));
+        }
+        buf += fab.size();
+    }
+
+    Gpu::streamSynchronize();
+
+#ifdef AMREX_USE_MPI
+    if (ParallelDescriptor::NProcs() > 1) {
+        MPI_Iallreduce(MPI_IN_PLACE, bcs.buffer.data(), static_cast<int>(n),
+                       ParallelDescriptor::Mpi_typemap<Real>::type(), MPI_SUM,
+                       ParallelDescriptor::Communicator(), &bcs.request);
+    }
+#endif
+}
+
+void
+Gravity::wait_bc_reduction (PendingBCFill& bcs)
+{
+    BL_PROFILE("Gravity::wait_bc_reduction()");
+
+#ifdef AMREX_USE_MPI
+    if (bcs.request != MPI_REQUEST_NULL) {
+        MPI_Wait(&bcs.request, MPI_STATUS_IGNORE);
+    }
+#endif
+
+    if (bcs.buffer.empty()) {
+        return;
+    }
+
+    const Real* buf = bcs.buffer.data();
+
+    for (auto& fab : bcs.fabs) {
+        if (fab.arena()->isHostAccessible()) {
+            std::memcpy(fab.dataPtr(), buf, fab.size() * sizeof(Real));
+        } else {
+            Gpu::htod_memcpy_async(fab.dataPtr(), buf, fab.size() * sizeof(Real));
+        }
+        buf += fab.size();
+    }
+
+    Gpu::streamSynchronize();
+
+    bcs.buffer.clear();
+}
+
+void
+Gravity::finish_phi_BCs (PendingBCFill& bcs, MultiFab& phi)
+{
+#if (AMREX_SPACEDIM == 3)
+    if (bcs.direct_sum) {
+        finish_direct_sum_BCs(bcs, phi);
+        return;
+    }
+#endif
+
+    finish_multipole_BCs(bcs, phi);
+}
+
 void
 Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
 {
     BL_PROFILE("Gravity::fill_multipole_BCs()");
 
+    auto bcs = start_multipole_BCs(crse_level, fine_level, Rhs);
+
+    finish_phi_BCs(*bcs, phi);
+}
+
+std::unique_ptr<Gravity::PendingBCFill>
+Gravity::start_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs)
+{
+    BL_PROFILE("Gravity::start_multipole_BCs()");
+
     // Multipole BCs only make sense to construct if we are starting from the coarse level.
 
     BL_ASSERT(crse_level == 0);
@@ -1813,9 +2617,9 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
     qUC.setVal<RunOn::Device>(0.0);
     qUS.setVal<RunOn::Device>(0.0);
 
-    // This section needs to be generalized for computing
-    // full multipole gravity, not just BCs. At present this
-    // does nothing.
+    // For the boundary values we only need the outermost bin. The
+    // full multipole gravity on the interior (MultipoleGrav) is done
+    // in make_multipole_gravity, which bins the moments more cheaply.
 
 #if (AMREX_SPACEDIM == 3)
     int boundary_only = 1;
@@ -1907,6 +2711,7 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
                 auto rho = source[mfi].array();
                 auto vol = (*volume[lev])[mfi].array();
 
+#ifdef AMREX_USE_GPU
                 amrex::ParallelFor(amrex::Gpu::KernelInfo().setReduction(true), bx,
                 [=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::Gpu::Handler const& handler) noexcept
                 {
@@ -1977,6 +2782,117 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
 
                     }
                 });
+#else
+                // On CPUs we collect the zones into blocks and add the
+                // whole block to the moments at once, so that the work
+                // vectorizes across zones.  The zones themselves get the
+                // parity factors and their symmetric images do not, as
+                // in multipole_add and multipole_symmetric_add, so they
+                // go in separate blocks.
+
+                amrex::ignore_unused(probhi);
+
+                const int nlo = (boundary_only == 1) ? npts-1 : 0;
+
+                const Real drInv = multipole::rmax / dx[0];
+                const Real rmax_cubed_inv = 1.0_rt / (multipole::rmax * multipole::rmax * multipole::rmax);
+
+                // The images of a zone across the symmetric lower
+                // boundaries: bit n of s reflects about boundary n.
+
+                int n_images = 0;
+                int images[7];
+
+                if (multipole::doSymmetricAdd) {
+                    for (int s = 1; s < 8; ++s) {
+                        bool valid = true;
+                        for (int n = 0; n < 3; ++n) {
+                            if ((s & (1 << n)) && !multipole::doSymmetricAddLo(n)) {
+                                valid = false;
+                            }
+                        }
+                        if (valid) {
+                            images[n_images++] = s;
+                        }
+                    }
+                }
+
+                Real rLo[3] = {0.0_rt};
+                for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                    rLo[n] = (2.0_rt * (problo[n] - problem::center[n])) / multipole::rmax;
+                }
+
+                MultipoleBlock zone_blk;
+                MultipoleBlock image_blk;
+
+                // The radial bin is always that of the zone itself, also
+                // for its images, as in multipole_symmetric_add.
+
+                auto add_point = [&] (MultipoleBlock& blk, Real x, Real y, Real z, Real mass,
+                                      int index, bool parity)
+                {
+                    const Real r = std::sqrt(x * x + y * y + z * z);
+
+                    Real cosTheta = 1.0_rt;
+                    Real phiAngle = 0.0_rt;
+
+                    if (AMREX_SPACEDIM == 3) {
+                        cosTheta = z / r;
+                        phiAngle = std::atan2(y, x);
+                    }
+                    else if (AMREX_SPACEDIM == 2 && coord_type == 1) {
+                        cosTheta = y / r;
+                        phiAngle = z;
+                    }
+
+                    blk.add(cosTheta, phiAngle, r, mass, index);
+
+                    if (blk.full()) {
+                        multipole_add_block(blk, qL0_arr, qLC_arr, qLS_arr, qU0_arr, qUC_arr, qUS_arr,
+                                            npts, nlo, parity);
+                    }
+                };
+
+                const auto lo = amrex::lbound(bx);
+                const auto hi = amrex::ubound(bx);
+
+                for (int k = lo.z; k <= hi.z; ++k) {
+                    for (int j = lo.y; j <= hi.y; ++j) {
+                        for (int i = lo.x; i <= hi.x; ++i) {
+
+                            const Real mass = rho(i,j,k) * vol(i,j,k) * rmax_cubed_inv;
+
+                            Real loc[3] = {0.0_rt};
+                            const int idx[3] = {i, j, k};
+                            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                                loc[n] = (problo[n] + (static_cast<Real>(idx[n]) + 0.5_rt) * dx[n] - problem::center[n]) / multipole::rmax;
+                            }
+
+                            int index = nlo;
+                            if (AMREX_SPACEDIM == 3) {
+                                index = static_cast<int>(std::sqrt(loc[0] * loc[0] + loc[1] * loc[1] + loc[2] * loc[2]) * drInv);
+                            }
+
+                            add_point(zone_blk, loc[0], loc[1], loc[2], mass, index, true);
+
+                            for (int s = 0; s < n_images; ++s) {
+                                Real img[3];
+                                for (int n = 0; n < 3; ++n) {
+                                    img[n] = (images[s] & (1 << n)) ? rLo[n] - loc[n] : loc[n];
+                                }
+
+                                add_point(image_blk, img[0], img[1], img[2], mass, index, false);
+                            }
+
+                        }
+                    }
+                }
+
+                multipole_add_block(zone_blk, qL0_arr, qLC_arr, qLS_arr, qU0_arr, qUC_arr, qUS_arr,
+                                    npts, nlo, true);
+                multipole_add_block(image_blk, qL0_arr, qLC_arr, qLS_arr, qU0_arr, qUC_arr, qUS_arr,
+                                    npts, nlo, false);
+#endif
             }
 
 #ifdef _OPENMP
@@ -2044,109 +2960,46 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
 
     } // end loop over levels
 
-    // Now, do a global reduce over all processes.
-
-    Real* qL0_ptr = qL0.dataPtr();
-    Real* qLC_ptr = qLC.dataPtr();
-    Real* qLS_ptr = qLS.dataPtr();
-
-    // Create temporary pinned host containers in case we need them.
-
-    FArrayBox qL0_host(The_Pinned_Arena());
-    FArrayBox qLC_host(The_Pinned_Arena());
-    FArrayBox qLS_host(The_Pinned_Arena());
-
-    if (!ParallelDescriptor::UseGpuAwareMpi()) {
-        if (The_Arena() == The_Managed_Arena()) {
-            qL0.prefetchToHost();
-            qLC.prefetchToHost();
-            qLS.prefetchToHost();
-        }
-        else if (The_Arena() == The_Device_Arena()) {
-            qL0_host.resize(boxq0);
-            qLC_host.resize(boxqC);
-            qLS_host.resize(boxqS);
-
-            qL0_host.copy<RunOn::Device>(qL0, boxq0);
-            qLC_host.copy<RunOn::Device>(qLC, boxqC);
-            qLS_host.copy<RunOn::Device>(qLS, boxqS);
-
-            qL0_ptr = qL0_host.dataPtr();
-            qLC_ptr = qLC_host.dataPtr();
-            qLS_ptr = qLS_host.dataPtr();
-        }
-    }
+    // Now, start the global reduce over all processes. Only the
+    // moments of the mass interior to the boundary are needed for the
+    // boundary values.
 
-    Gpu::synchronize();
-
-    ParallelDescriptor::ReduceRealSum(qL0_ptr, static_cast<int>(boxq0.numPts()));
-    ParallelDescriptor::ReduceRealSum(qLC_ptr, static_cast<int>(boxqC.numPts()));
-    ParallelDescriptor::ReduceRealSum(qLS_ptr, static_cast<int>(boxqS.numPts()));
-
-    if (!ParallelDescriptor::UseGpuAwareMpi()) {
-        if (The_Arena() == The_Managed_Arena()) {
-            qL0.prefetchToDevice();
-            qLC.prefetchToDevice();
-            qLS.prefetchToDevice();
-        }
-        else if (The_Arena() == The_Device_Arena()) {
-            qL0.copy<RunOn::Device>(qL0_host, boxq0);
-            qLC.copy<RunOn::Device>(qLC_host, boxqC);
-            qLS.copy<RunOn::Device>(qLS_host, boxqS);
-        }
-    }
+    auto bcs = std::make_unique<PendingBCFill>();
 
-    if (boundary_only != 1) {
+    bcs->crse_level = crse_level;
+    bcs->fine_level = fine_level;
+    bcs->direct_sum = false;
+    bcs->strt = strt;
 
-        Real* qU0_ptr = qU0.dataPtr();
-        Real* qUC_ptr = qUC.dataPtr();
-        Real* qUS_ptr = qUS.dataPtr();
+    bcs->fabs.push_back(std::move(qL0));
+    bcs->fabs.push_back(std::move(qLC));
+    bcs->fabs.push_back(std::move(qLS));
 
-        FArrayBox qU0_host(The_Pinned_Arena());
-        FArrayBox qUC_host(The_Pinned_Arena());
-        FArrayBox qUS_host(The_Pinned_Arena());
+    start_bc_reduction(*bcs);
 
-        if (!ParallelDescriptor::UseGpuAwareMpi()) {
-            if (The_Arena() == The_Managed_Arena()) {
-                qU0.prefetchToHost();
-                qUC.prefetchToHost();
-                qUS.prefetchToHost();
-            }
-            else if (The_Arena() == The_Device_Arena()) {
-                qU0_host.resize(boxq0);
-                qUC_host.resize(boxqC);
-                qUS_host.resize(boxqS);
+    return bcs;
+}
 
-                qU0_host.copy<RunOn::Device>(qU0, boxq0);
-                qUC_host.copy<RunOn::Device>(qUC, boxqC);
-                qUS_host.copy<RunOn::Device>(qUS, boxqS);
+void
+Gravity::finish_multipole_BCs(PendingBCFill& bcs, MultiFab& phi)
+{
+    BL_PROFILE("Gravity::finish_multipole_BCs()");
 
-                qU0_ptr = qU0_host.dataPtr();
-                qUC_ptr = qUC_host.dataPtr();
-                qUS_ptr = qUS_host.dataPtr();
-            }
-        }
+    wait_bc_reduction(bcs);
 
-        Gpu::synchronize();
+    const int crse_level = bcs.crse_level;
 
-        ParallelDescriptor::ReduceRealSum(qU0_ptr, static_cast<int>(boxq0.numPts()));
-        ParallelDescriptor::ReduceRealSum(qUC_ptr, static_cast<int>(boxqC.numPts()));
-        ParallelDescriptor::ReduceRealSum(qUS_ptr, static_cast<int>(boxqS.numPts()));
+    const FArrayBox& qL0 = bcs.fabs[0];
+    const FArrayBox& qLC = bcs.fabs[1];
+    const FArrayBox& qLS = bcs.fabs[2];
 
-        if (!ParallelDescriptor::UseGpuAwareMpi()) {
-            if (The_Arena() == The_Managed_Arena()) {
-                qU0.prefetchToDevice();
-                qUC.prefetchToDevice();
-                qUS.prefetchToDevice();
-            }
-            else if (The_Arena() == The_Device_Arena()) {
-                qU0.copy<RunOn::Device>(qU0_host, boxq0);
-                qUC.copy<RunOn::Device>(qUC_host, boxqC);
-                qUS.copy<RunOn::Device>(qUS_host, boxqS);
-            }
-        }
+#if (AMREX_SPACEDIM == 3)
+    const int npts = numpts_at_level;
+#else
+    const int npts = 1;
+#endif
 
-    }
+    const int boundary_only = 1;
 
     // Finally, construct the boundary conditions using the
     // complete multipole moments, for all points on the
@@ -2315,472 +3168,261 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
     if (gravity::verbose)
     {
         const int IOProc = ParallelDescriptor::IOProcessorNumber();
-        Real      end    = ParallelDescriptor::second() - strt;
+        Real      end    = ParallelDescriptor::second() - bcs.strt;
 
 #ifdef BL_LAZY
         Lazy::QueueReduction( [=] () mutable {
 #endif
         ParallelDescriptor::ReduceRealMax(end,IOProc);
         amrex::Print() << "Gravity::fill_multipole_BCs() time = " << end << std::endl << std::endl;
-#ifdef BL_LAZY
-        });
-#endif
-    }
-
-}
-
-#if (AMREX_SPACEDIM == 3)
-void
-Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
-{
-    BL_PROFILE("Gravity::fill_direct_sum_BCs()");
-
-    BL_ASSERT(crse_level==0);
-
-    const Real strt = ParallelDescriptor::second();
-
-    const Geometry& crse_geom = parent->Geom(crse_level);
-
-    // Storage arrays for the BCs.
-
-    const int* domlo = crse_geom.Domain().loVect();
-    const int* domhi = crse_geom.Domain().hiVect();
-
-    const int loVectXY[3] = {domlo[0]-1, domlo[1]-1, 0         };
-    const int hiVectXY[3] = {domhi[0]+1, domhi[1]+1, 0         };
-
-    const int loVectXZ[3] = {domlo[0]-1, 0         , domlo[2]-1};
-    const int hiVectXZ[3] = {domhi[0]+1, 0         , domhi[2]+1};
-
-    const int loVectYZ[3] = {0         , domlo[1]-1, domlo[2]-1};
-    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[1]+1};
-
-    const int bc_lo[3] = {domlo[0]-1, domlo[1]-1, domlo[2]-1};
-    const int bc_hi[3] = {domhi[0]+1, domhi[1]+1, domhi[2]+1};
-
-    GpuArray<Real, 3> bc_dx;
-    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-        bc_dx[n] = crse_geom.CellSizeArray()[n];
-    }
-    for (int n = AMREX_SPACEDIM; n < 3; ++n) {
-        bc_dx[n] = 0.0_rt;
-    }
-
-    GpuArray<Real, 3> problo;
-    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-        problo[n] = crse_geom.ProbLoArray()[n];
-    }
-    for (int n = AMREX_SPACEDIM; n < 3; ++n) {
-        problo[n] = 0.0_rt;
-    }
-
-    GpuArray<Real, 3> probhi;
-    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-        probhi[n] = crse_geom.ProbHiArray()[n];
-    }
-    for (int n = AMREX_SPACEDIM; n < 3; ++n) {
-        probhi[n] = 0.0_rt;
-    }
-
-    IntVect smallEndXY( loVectXY );
-    IntVect bigEndXY  ( hiVectXY );
-    IntVect smallEndXZ( loVectXZ );
-    IntVect bigEndXZ  ( hiVectXZ );
-    IntVect smallEndYZ( loVectYZ );
-    IntVect bigEndYZ  ( hiVectYZ );
-
-    Box boxXY(smallEndXY, bigEndXY);
-    Box boxXZ(smallEndXZ, bigEndXZ);
-    Box boxYZ(smallEndYZ, bigEndYZ);
-
-    const long nPtsXY = boxXY.numPts();
-    const long nPtsXZ = boxXZ.numPts();
-    const long nPtsYZ = boxYZ.numPts();
-
-    FArrayBox bcXYLo(boxXY);
-    FArrayBox bcXYHi(boxXY);
-    FArrayBox bcXZLo(boxXZ);
-    FArrayBox bcXZHi(boxXZ);
-    FArrayBox bcYZLo(boxYZ);
-    FArrayBox bcYZHi(boxYZ);
-
-    bcXYLo.setVal<RunOn::Device>(0.0);
-    bcXYHi.setVal<RunOn::Device>(0.0);
-    bcXZLo.setVal<RunOn::Device>(0.0);
-    bcXZHi.setVal<RunOn::Device>(0.0);
-    bcYZLo.setVal<RunOn::Device>(0.0);
-    bcYZHi.setVal<RunOn::Device>(0.0);
-
-    // Loop through the grids and compute the individual contributions
-    // to the BCs. The BC constructor is coded to only add to the
-    // BCs, so it is safe to directly hand the arrays to them.
-
-    int physbc_lo[3];
-    int physbc_hi[3];
-
-    for (int dir = 0; dir < 3; dir++) {
-        physbc_lo[dir] = phys_bc->lo(dir);
-        physbc_hi[dir] = phys_bc->hi(dir);
-    }
-
-    for (int lev = crse_level; lev <= fine_level; ++lev) {
-
-        // Create a local copy of the RHS so that we can mask it.
-
-        MultiFab source(Rhs[lev - crse_level]->boxArray(),
-                        Rhs[lev - crse_level]->DistributionMap(),
-                        1, 0);
-
-        MultiFab::Copy(source, *Rhs[lev - crse_level], 0, 0, 1, 0);
-
-        if (lev < fine_level) {
-            const MultiFab& mask = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)))->build_fine_mask();
-            MultiFab::Multiply(source, mask, 0, 0, 1, 0);
-        }
-
-        const auto dx = parent->Geom(lev).CellSizeArray();
-
-#ifdef _OPENMP
-        int nthreads = omp_get_max_threads();
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXYLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXYHi(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXZLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXZHi(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcYZLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcYZHi(nthreads);
-        for (int i=0; i<nthreads; i++) {
-            priv_bcXYLo[i].reset(new FArrayBox(boxXY));
-            priv_bcXYHi[i].reset(new FArrayBox(boxXY));
-            priv_bcXZLo[i].reset(new FArrayBox(boxXZ));
-            priv_bcXZHi[i].reset(new FArrayBox(boxXZ));
-            priv_bcYZLo[i].reset(new FArrayBox(boxYZ));
-            priv_bcYZHi[i].reset(new FArrayBox(boxYZ));
-        }
-#pragma omp parallel
-#endif
-        {
-#ifdef _OPENMP
-            int tid = omp_get_thread_num();
-            priv_bcXYLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXYHi[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXZLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXZHi[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcYZLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcYZHi[tid]->setVal<RunOn::Gpu>(0.0);
-#endif
-            for (MFIter mfi(source, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-            {
-                const Box bx = mfi.tilebox();
-
-                const auto rho = source[mfi].array();
-                const auto vol = (*volume[lev])[mfi].array();
-
-                // Determine if we need to add contributions from any symmetric boundaries.
-
-                GpuArray<bool, 3> doSymmetricAddLo {false};
-                GpuArray<bool, 3> doSymmetricAddHi {false};
-                bool doSymmetricAdd {false};
-
-                for (int b = 0; b < 3; ++b) {
-                    if (physbc_lo[b] == amrex::PhysBCType::symmetry) {
-                        doSymmetricAddLo[b] = true;
-                        doSymmetricAdd      = true;
-                    }
-
-                    if (physbc_hi[b] == amrex::PhysBCType::symmetry) {
-                        doSymmetricAddHi[b] = true;
-                        doSymmetricAdd      = true;
-                    }
-                }
-
-#ifdef _OPENMP
-                auto bcXYLo_arr = priv_bcXYLo[tid]->array();
-                auto bcXYHi_arr = priv_bcXYHi[tid]->array();
-                auto bcXZLo_arr = priv_bcXZLo[tid]->array();
-                auto bcXZHi_arr = priv_bcXZHi[tid]->array();
-                auto bcYZLo_arr = priv_bcYZLo[tid]->array();
-                auto bcYZHi_arr = priv_bcYZHi[tid]->array();
-#else
-                auto bcXYLo_arr = bcXYLo.array();
-                auto bcXYHi_arr = bcXYHi.array();
-                auto bcXZLo_arr = bcXZLo.array();
-                auto bcXZHi_arr = bcXZHi.array();
-                auto bcYZLo_arr = bcYZLo.array();
-                auto bcYZHi_arr = bcYZHi.array();
-#endif
-
-                amrex::ParallelFor(bx,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    GpuArray<Real, 3> loc, locb;
-                    loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
-
-#if AMREX_SPACEDIM >= 2
-                    loc[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1];
-#else
-                    loc[1] = 0.0_rt;
-#endif
-
-#if AMREX_SPACEDIM == 3
-                    loc[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2];
-#else
-                    loc[2] = 0.0_rt;
-#endif
-
-                    // Do xy interfaces first. Note that the boundary conditions
-                    // on phi are expected to live directly on the interface.
-                    // We also have to handle the domain corners correctly. We are
-                    // assuming that bc_lo = domlo - 1 and bc_hi = domhi + 1, where
-                    // domlo and domhi are the coarse domain extent.
-
-                    for (int m = bc_lo[1]; m <= bc_hi[1]; ++m) {
-                        if (m == bc_lo[1]) {
-                            locb[1] = problo[1];
-                        }
-                        else if (m == bc_hi[1]) {
-                            locb[1] = probhi[1];
-                        }
-                        else {
-                            locb[1] = problo[1] + (static_cast<Real>(m) + 0.5_rt) * bc_dx[1];
-                        }
-                        Real dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
-
-                        for (int l = bc_lo[0]; l <= bc_hi[0]; ++l) {
-                            if (l == bc_lo[0]) {
-                                locb[0] = problo[0];
-                            }
-                            else if (l == bc_hi[0]) {
-                                locb[0] = probhi[1];
-                            }
-                            else {
-                                locb[0] = problo[0] + (static_cast<Real>(l) + 0.5_rt) * bc_dx[0];
-                            }
-                            Real dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
-
-                            locb[2] = problo[2];
-                            Real dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
-
-                            Real r = std::sqrt(dx2 + dy2 + dz2);
-
-                            Real dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
-
-                            // Now, add any contributions from mass that is hidden behind
-                            // a symmetric boundary.
+#ifdef BL_LAZY
+        });
+#endif
+    }
 
-                            if (doSymmetricAdd) {
+}
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+#if (AMREX_SPACEDIM == 3)
+void
+Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
+{
+    BL_PROFILE("Gravity::fill_direct_sum_BCs()");
 
-                            }
+    auto bcs = start_direct_sum_BCs(crse_level, fine_level, Rhs);
 
-                            Gpu::Atomic::Add(&bcXYLo_arr(l,m,0), dbc);
+    finish_phi_BCs(*bcs, phi);
+}
 
-                            locb[2] = probhi[2];
-                            dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
+std::unique_ptr<Gravity::PendingBCFill>
+Gravity::start_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs)
+{
+    BL_PROFILE("Gravity::start_direct_sum_BCs()");
 
-                            r = std::sqrt(dx2 + dy2 + dz2);
+    BL_ASSERT(crse_level==0);
 
-                            dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+    const Real strt = ParallelDescriptor::second();
 
-                            if (doSymmetricAdd) {
+    const Geometry& crse_geom = parent->Geom(crse_level);
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+    // Storage arrays for the BCs.
 
-                            }
+    const int* domlo = crse_geom.Domain().loVect();
+    const int* domhi = crse_geom.Domain().hiVect();
 
-                            Gpu::Atomic::Add(&bcXYHi_arr(l,m,0), dbc);
+    const int loVectXY[3] = {domlo[0]-1, domlo[1]-1, 0         };
+    const int hiVectXY[3] = {domhi[0]+1, domhi[1]+1, 0         };
 
-                        }
+    const int loVectXZ[3] = {domlo[0]-1, 0         , domlo[2]-1};
+    const int hiVectXZ[3] = {domhi[0]+1, 0         , domhi[2]+1};
 
-                    }
+    const int loVectYZ[3] = {0         , domlo[1]-1, domlo[2]-1};
+    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[2]+1};
 
-                    // Now do xz interfaces.
+    const int bc_lo[3] = {domlo[0]-1, domlo[1]-1, domlo[2]-1};
+    const int bc_hi[3] = {domhi[0]+1, domhi[1]+1, domhi[2]+1};
 
-                    for (int n = bc_lo[2]; n <= bc_hi[2]; ++n) {
-                        if (n == bc_lo[2]) {
-                            locb[2] = problo[2];
-                        }
-                        else if (n == bc_hi[2]) {
-                            locb[2] = probhi[2];
-                        }
-                        else {
-                            locb[2] = problo[2] + (static_cast<Real>(n) + 0.5_rt) * bc_dx[2];
-                        }
-                        Real dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
+    const auto bc_dx = crse_geom.CellSizeArray();
+    const auto problo = crse_geom.ProbLoArray();
+    const auto probhi = crse_geom.ProbHiArray();
 
-                        for (int l = bc_lo[0]; l <= bc_hi[0]; ++l) {
-                            if (l == bc_lo[0]) {
-                                locb[0] = problo[0];
-                            }
-                            else if (l == bc_hi[0]) {
-                                locb[0] = probhi[0];
-                            }
-                            else {
-                                locb[0] = problo[0] + (static_cast<Real>(l) + 0.5_rt) * bc_dx[0];
-                            }
-                            Real dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
+    IntVect smallEndXY( loVectXY );
+    IntVect bigEndXY  ( hiVectXY );
+    IntVect smallEndXZ( loVectXZ );
+    IntVect bigEndXZ  ( hiVectXZ );
+    IntVect smallEndYZ( loVectYZ );
+    IntVect bigEndYZ  ( hiVectYZ );
 
-                            locb[1] = problo[1];
-                            Real dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
+    Box boxXY(smallEndXY, bigEndXY);
+    Box boxXZ(smallEndXZ, bigEndXZ);
+    Box boxYZ(smallEndYZ, bigEndYZ);
 
-                            Real r = std::sqrt(dx2 + dy2 + dz2);
+    // These are filled on the host and read on the device.
 
-                            Real dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+    FArrayBox bcXYLo(boxXY, 1, The_Pinned_Arena());
+    FArrayBox bcXYHi(boxXY, 1, The_Pinned_Arena());
+    FArrayBox bcXZLo(boxXZ, 1, The_Pinned_Arena());
+    FArrayBox bcXZHi(boxXZ, 1, The_Pinned_Arena());
+    FArrayBox bcYZLo(boxYZ, 1, The_Pinned_Arena());
+    FArrayBox bcYZHi(boxYZ, 1, The_Pinned_Arena());
 
-                            if (doSymmetricAdd) {
+    // Rather than summing the contribution of every zone to every
+    // boundary point, we build a Barnes-Hut tree over the zones that
+    // this rank owns (on all levels, with the zones covered by a finer
+    // level masked out) and evaluate the potential of the tree at each
+    // boundary point.  Each rank then holds the contribution of its
+    // own mass to the BCs, and a global reduce adds them up, as in the
+    // direct sum.  With gravity.direct_sum_bcs_theta = 0 every node is
+    // opened and this is the exact direct sum.
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+    GravityTree tree(gravity::direct_sum_bcs_theta);
 
-                            }
+    for (int lev = crse_level; lev <= fine_level; ++lev) {
 
-                            Gpu::Atomic::Add(&bcXZLo_arr(l,0,n), dbc);
+        // Create a local copy of the RHS so that we can mask it and
+        // turn it into the mass of each zone.
 
-                            locb[1] = probhi[1];
-                            dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
+        MultiFab source(Rhs[lev - crse_level]->boxArray(),
+                        Rhs[lev - crse_level]->DistributionMap(),
+                        1, 0);
 
-                            r = std::sqrt(dx2 + dy2 + dz2);
+        MultiFab::Copy(source, *Rhs[lev - crse_level], 0, 0, 1, 0);
 
-                            dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+        if (lev < fine_level) {
+            const MultiFab& mask = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)))->build_fine_mask();
+            MultiFab::Multiply(source, mask, 0, 0, 1, 0);
+        }
 
-                            if (doSymmetricAdd) {
+        MultiFab::Multiply(source, *volume[lev], 0, 0, 1, 0);
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+        for (MFIter mfi(source); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
 
-                            }
+#ifdef AMREX_USE_GPU
+            FArrayBox mass(bx, 1, The_Pinned_Arena());
+            mass.copy<RunOn::Device>(source[mfi], bx);
+            Gpu::streamSynchronize();
 
-                            Gpu::Atomic::Add(&bcXZHi_arr(l,0,n), dbc);
+            tree.addBox(bx, mass.const_array(), parent->Geom(lev));
+#else
+            tree.addBox(bx, source.const_array(mfi), parent->Geom(lev));
+#endif
+        }
 
-                        }
+    } // end loop over levels
 
-                    }
+    // The mass hidden behind a symmetric boundary is the mirror image
+    // of the mass on the grid.  Its potential at a boundary point is
+    // that of the mass on the grid at the mirror image of the point,
+    // so we evaluate the tree there too, once for every combination
+    // of reflections across the symmetric lower (-1) or upper (+1)
+    // boundaries.
 
-                    // Finally, do yz interfaces.
+    Vector<Array<int, 3>> images;
 
-                    for (int n = bc_lo[2]; n <= bc_hi[2]; ++n) {
-                        if (n == bc_lo[2]) {
-                            locb[2] = problo[2];
-                        }
-                        else if (n == bc_hi[2]) {
-                            locb[2] = probhi[2];
-                        }
-                        else {
-                            locb[2] = problo[2] + (static_cast<Real>(n) + 0.5_rt) * bc_dx[2];
-                        }
-                        Real dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
+    for (int m = 1; m < 27; ++m) {
+        Array<int, 3> reflect{0, 0, 0};
+        bool valid = true;
 
-                        for (int m = bc_lo[1]; m <= bc_hi[1]; ++m) {
-                            if (m == bc_lo[1]) {
-                                locb[1] = problo[1];
-                            }
-                            else if (m == bc_hi[1]) {
-                                locb[1] = probhi[1];
-                            }
-                            else {
-                                locb[1] = problo[1] + (static_cast<Real>(m) + 0.5_rt) * bc_dx[1];
-                            }
-                            Real dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
+        for (int dir = 0, mm = m; dir < 3; ++dir, mm /= 3) {
+            reflect[dir] = (mm % 3 == 2) ? -1 : mm % 3;
 
-                            locb[0] = problo[0];
-                            Real dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
+            if ((reflect[dir] == -1 && phys_bc->lo(dir) != amrex::PhysBCType::symmetry) ||
+                (reflect[dir] == 1 && phys_bc->hi(dir) != amrex::PhysBCType::symmetry)) {
+                valid = false;
+            }
+        }
 
-                            Real r = std::sqrt(dx2 + dy2 + dz2);
+        if (valid) {
+            images.push_back(reflect);
+        }
+    }
 
-                            Real dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+    // the location of the boundary point with index idx in direction
+    // dir -- the BCs live directly on the domain faces
 
-                            if (doSymmetricAdd) {
+    auto bc_loc = [&] (int dir, int idx) -> Real
+    {
+        if (idx == bc_lo[dir]) {
+            return problo[dir];
+        }
+        else if (idx == bc_hi[dir]) {
+            return probhi[dir];
+        }
+        return problo[dir] + (static_cast<Real>(idx) + 0.5_rt) * bc_dx[dir];
+    };
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+    // fill the boundary points on the lo or hi face normal to
+    // direction normal
 
-                            }
+    auto fill_face = [&] (FArrayBox& bc, int normal, bool hi_face)
+    {
+        const Box& bx = bc.box();
+        const Long npts = bx.numPts();
+        auto bc_arr = bc.array();
 
-                            Gpu::Atomic::Add(&bcYZLo_arr(0,m,n), dbc);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for (Long n = 0; n < npts; ++n) {
+            const IntVect iv = bx.atOffset(n);
 
-                            locb[0] = probhi[0];
-                            dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
+            GpuArray<Real, 3> locb;
+            for (int dir = 0; dir < 3; ++dir) {
+                if (dir == normal) {
+                    locb[dir] = hi_face ? probhi[dir] : problo[dir];
+                } else {
+                    locb[dir] = bc_loc(dir, iv[dir]);
+                }
+            }
 
-                            r = std::sqrt(dx2 + dy2 + dz2);
+            Real bcval = tree.potential(locb);
+
+            for (const auto& reflect : images) {
+                GpuArray<Real, 3> locm;
+                for (int dir = 0; dir < 3; ++dir) {
+                    if (reflect[dir] == -1) {
+                        locm[dir] = 2.0_rt * problo[dir] - locb[dir];
+                    } else if (reflect[dir] == 1) {
+                        locm[dir] = 2.0_rt * probhi[dir] - locb[dir];
+                    } else {
+                        locm[dir] = locb[dir];
+                    }
+                }
+                bcval += tree.potential(locm);
+            }
 
-                            dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+            bc_arr(iv) = bcval;
+        }
+    };
 
-                            if (doSymmetricAdd) {
+    fill_face(bcXYLo, 2, false);
+    fill_face(bcXYHi, 2, true);
+    fill_face(bcXZLo, 1, false);
+    fill_face(bcXZHi, 1, true);
+    fill_face(bcYZLo, 0, false);
+    fill_face(bcYZHi, 0, true);
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+    // Start the global reduce over all processes.
 
-                            }
+    auto bcs = std::make_unique<PendingBCFill>();
 
-                            Gpu::Atomic::Add(&bcYZHi_arr(0,m,n), dbc);
+    bcs->crse_level = crse_level;
+    bcs->fine_level = fine_level;
+    bcs->direct_sum = true;
+    bcs->strt = strt;
+    bcs->tree_nodes = tree.numNodes();
 
-                        }
+    bcs->fabs.push_back(std::move(bcXYLo));
+    bcs->fabs.push_back(std::move(bcXYHi));
+    bcs->fabs.push_back(std::move(bcXZLo));
+    bcs->fabs.push_back(std::move(bcXZHi));
+    bcs->fabs.push_back(std::move(bcYZLo));
+    bcs->fabs.push_back(std::move(bcYZHi));
 
-                    }
+    start_bc_reduction(*bcs);
 
-                });
+    return bcs;
+}
 
-            }
+void
+Gravity::finish_direct_sum_BCs(PendingBCFill& bcs, MultiFab& phi)
+{
+    BL_PROFILE("Gravity::finish_direct_sum_BCs()");
 
-#ifdef _OPENMP
-            Real* pXYLo = bcXYLo.dataPtr();
-            Real* pXYHi = bcXYHi.dataPtr();
-            Real* pXZLo = bcXZLo.dataPtr();
-            Real* pXZHi = bcXZHi.dataPtr();
-            Real* pYZLo = bcYZLo.dataPtr();
-            Real* pYZHi = bcYZHi.dataPtr();
-#pragma omp barrier
-#pragma omp for nowait
-            for (int i=0; i<nPtsXY; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcXYLo[it]->dataPtr();
-                    const Real* ph = priv_bcXYHi[it]->dataPtr();
-                    pXYLo[i] += pl[i];
-                    pXYHi[i] += ph[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<nPtsXZ; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcXZLo[it]->dataPtr();
-                    const Real* ph = priv_bcXZHi[it]->dataPtr();
-                    pXZLo[i] += pl[i];
-                    pXZHi[i] += ph[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<nPtsYZ; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcYZLo[it]->dataPtr();
-                    const Real* ph = priv_bcYZHi[it]->dataPtr();
-                    pYZLo[i] += pl[i];
-                    pYZHi[i] += ph[i];
-                }
-            }
-#endif
-        }
+    wait_bc_reduction(bcs);
 
-    } // end loop over levels
+    const Box& domain = parent->Geom(bcs.crse_level).Domain();
 
-    // because the number of elements in mpi_reduce is int
-    BL_ASSERT(nPtsXY <= std::numeric_limits<int>::max());
-    BL_ASSERT(nPtsXZ <= std::numeric_limits<int>::max());
-    BL_ASSERT(nPtsYZ <= std::numeric_limits<int>::max());
+    const int bc_lo[3] = {domain.smallEnd(0)-1, domain.smallEnd(1)-1, domain.smallEnd(2)-1};
+    const int bc_hi[3] = {domain.bigEnd(0)+1, domain.bigEnd(1)+1, domain.bigEnd(2)+1};
 
-    ParallelDescriptor::ReduceRealSum(bcXYLo.dataPtr(), nPtsXY);
-    ParallelDescriptor::ReduceRealSum(bcXYHi.dataPtr(), nPtsXY);
-    ParallelDescriptor::ReduceRealSum(bcXZLo.dataPtr(), nPtsXZ);
-    ParallelDescriptor::ReduceRealSum(bcXZHi.dataPtr(), nPtsXZ);
-    ParallelDescriptor::ReduceRealSum(bcYZLo.dataPtr(), nPtsYZ);
-    ParallelDescriptor::ReduceRealSum(bcYZHi.dataPtr(), nPtsYZ);
+    const FArrayBox& bcXYLo = bcs.fabs[0];
+    const FArrayBox& bcXYHi = bcs.fabs[1];
+    const FArrayBox& bcXZLo = bcs.fabs[2];
+    const FArrayBox& bcXZHi = bcs.fabs[3];
+    const FArrayBox& bcYZLo = bcs.fabs[4];
+    const FArrayBox& bcYZHi = bcs.fabs[5];
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -2827,16 +3469,22 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
         });
     }
 
+    // the BC arrays are destroyed with bcs
+    Gpu::streamSynchronize();
+
     if (gravity::verbose)
     {
         const int IOProc = ParallelDescriptor::IOProcessorNumber();
-        Real      end    = ParallelDescriptor::second() - strt;
+        Real      end    = ParallelDescriptor::second() - bcs.strt;
+        Long      nodes  = bcs.tree_nodes;
 
 #ifdef BL_LAZY
         Lazy::QueueReduction( [=] () mutable {
 #endif
         ParallelDescriptor::ReduceRealMax(end,IOProc);
-        amrex::Print() << "Gravity::fill_direct_sum_BCs() time = " << end << std::endl << std::endl;
+        ParallelDescriptor::ReduceLongSum(nodes,IOProc);
+        amrex::Print() << "Gravity::fill_direct_sum_BCs() time = " << end
+                       << " (" << nodes << " tree nodes)" << std::endl << std::endl;
 #ifdef BL_LAZY
         });
 #endif
@@ -3073,6 +3721,65 @@ Gravity::add_pointmass_to_gravity (int level, MultiFab& phi, MultiFab& grav_vect
     }
 }
 
+void
+Gravity::add_point_masses_to_gravity (int level, MultiFab& phi, MultiFab& grav_vector) const
+{
+    BL_PROFILE("Gravity::add_point_masses_to_gravity()");
+
+    const auto dx     = parent->Geom(level).CellSizeArray();
+    const auto problo = parent->Geom(level).ProbLoArray();
+
+    const PointMassSet pm = point_masses;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(grav_vector, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
+
+        Array4<Real> const grav_arr = grav_vector.array(mfi);
+        Array4<Real> const phi_arr = phi.array(mfi);
+
+        // The potential and the acceleration are evaluated together,
+        // and there is no branching in the sum over the point masses,
+        // so on CPUs this vectorizes over i.
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real x = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
+#if AMREX_SPACEDIM >= 2
+            Real y = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1];
+#else
+            Real y = 0.0_rt;
+#endif
+#if AMREX_SPACEDIM == 3
+            Real z = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2];
+#else
+            Real z = 0.0_rt;
+#endif
+
+            Real p = 0.0_rt;
+            Real g[3] = {0.0_rt};
+
+            point_mass_phi_and_grav(pm, x, y, z, p, g);
+
+            // Note that grav may have more ghost zones than
+            // phi, so we need to check that we're doing
+            // valid indexing here.
+
+            if (phi_arr.contains(i,j,k)) {
+                phi_arr(i,j,k) += p;
+            }
+
+            grav_arr(i,j,k,0) += g[0];
+            grav_arr(i,j,k,1) += g[1];
+            grav_arr(i,j,k,2) += g[2];
+        });
+    }
+}
+
 void
 Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
 {
@@ -3091,37 +3798,33 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
         const Real t_new = LevelData[lev]->get_state_data(State_Type).curTime();
         const Real eps   = (t_new - t_old) * 1.e-6;
 
-        // Create MultiFab with NUM_STATE components and no ghost cells
-        MultiFab S(grids[lev],dmap[lev],NUM_STATE,0);
+        // Rather than building a time-interpolated copy of the whole
+        // state, we hand the old and new data to compute_radial_mass
+        // with their weights, and it reads just the density (and,
+        // for GR, the fields the EOS needs) zone by zone.
+
+        Real a_old = 0.0_rt;
+        Real a_new = 0.0_rt;
 
         if ( eps == 0.0 ) {  // NOLINT(bugprone-branch-clone,-warnings-as-errors)
             // Old and new time are identical; this should only happen if
             // dt is smaller than roundoff compared to the current time,
             // in which case we're probably in trouble anyway,
             // but we will still handle it gracefully here.
-            MultiFab::Copy(S, LevelData[lev]->get_new_data(State_Type), 0, 0, NUM_STATE, 0);
+            a_new = 1.0_rt;
         }
         else if ( std::abs(time-t_old) < eps)
         {
-            MultiFab::Copy(S, LevelData[lev]->get_old_data(State_Type), 0, 0, NUM_STATE, 0);
+            a_old = 1.0_rt;
         }
         else if ( std::abs(time-t_new) < eps)
         {
-            MultiFab::Copy(S, LevelData[lev]->get_new_data(State_Type), 0, 0, NUM_STATE, 0);
+            a_new = 1.0_rt;
         }
         else if (time > t_old && time < t_new)
         {
-            Real alpha   = (time - t_old)/(t_new - t_old);
-            Real omalpha = 1.0 - alpha;
-
-            MultiFab::Copy(S, LevelData[lev]->get_old_data(State_Type), 0, 0, NUM_STATE, 0);
-            S.mult(omalpha);
-
-            MultiFab S_new(grids[lev],dmap[lev],NUM_STATE,0);
-            MultiFab::Copy(S_new, LevelData[lev]->get_new_data(State_Type), 0, 0, NUM_STATE, 0);
-            S_new.mult(alpha);
-
-            S.plus(S_new,0,NUM_STATE,0);
+            a_new = (time - t_old)/(t_new - t_old);
+            a_old = 1.0 - a_new;
         }
         else
         {
@@ -3130,15 +3833,17 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
             amrex::Abort("Problem in Gravity::make_radial_gravity");
         }
 
+        const MultiFab& S_old = LevelData[lev]->get_old_data(State_Type);
+        const MultiFab& S_new = LevelData[lev]->get_new_data(State_Type);
+
+        const MultiFab* mask = nullptr;
+
         if (lev < level)
         {
             auto* fine_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
-        if (fine_level != nullptr) {
-        const MultiFab& mask = fine_level->build_fine_mask();
-        for (int n = 0; n < NUM_STATE; ++n) {
-            MultiFab::Multiply(S, mask, 0, n, 1, 0);
-        }
-        } else {
+            if (fine_level != nullptr) {
+                mask = &(fine_level->build_fine_mask());
+            } else {
                 amrex::Abort("unable to create mask");
             }
         }
@@ -3181,13 +3886,15 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
 #ifdef _OPENMP
             int tid = omp_get_thread_num();
 #endif
-            for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 const Box& bx = mfi.tilebox();
-                FArrayBox& fab = S[mfi];
 
                 compute_radial_mass(bx,
-                                    fab.array(),
+                                    S_old.const_array(mfi),
+                                    S_new.const_array(mfi),
+                                    a_old, a_new,
+                                    mask != nullptr ? mask->const_array(mfi) : Array4<Real const>{},
 #ifdef _OPENMP
                                     priv_radial_mass[tid],
                                     priv_radial_vol[tid],
@@ -3621,12 +4328,45 @@ Gravity::solve_phi_with_mlmg (int crse_level, int fine_level,
 
     int nlevs = fine_level-crse_level+1;
 
+    // Use the boundary conditions started by start_phi_BCs if they
+    // are for this solve; anything else is stale.
+
+    std::unique_ptr<PendingBCFill> bcs = std::move(pending_bc_fill);
+
+    if (bcs && (bcs->crse_level != crse_level || bcs->fine_level != fine_level)) {
+        wait_bc_reduction(*bcs);
+        bcs.reset();
+    }
+
+#ifdef AMREX_USE_FFT
+    // The FFT solve needs no boundary conditions and has no iteration
+    // tolerance, so we report the tolerance MLMG would have been held
+    // to as its residual (this sets the tolerance of the sync solves).
+
+    if (use_fft_solve(crse_level, fine_level) && res.empty())
+    {
+        if (bcs) {
+            wait_bc_reduction(*bcs);
+        }
+
+        rhs[0]->mult(Ggravity);
+
+        solve_phi_with_fft(*phi[0], *rhs[0], grad_phi[0]);
+
+        return abs_tol[0] * max_rhs;
+    }
+#endif
+
     if (crse_level == 0 && !(parent->Geom(0).isAllPeriodic()))
     {
         if (gravity::verbose > 1) {
             amrex::Print() << " ... Making bc's for phi at level 0\n";
         }
 
+        if (bcs) {
+            finish_phi_BCs(*bcs, *phi[0]);
+        }
+        else {
 #if (AMREX_SPACEDIM == 3)
         if ( gravity::direct_sum_bcs ) {
             fill_direct_sum_BCs(crse_level, fine_level, rhs, *phi[0]);
@@ -3638,6 +4378,10 @@ Gravity::solve_phi_with_mlmg (int crse_level, int fine_level,
 #else
         fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0]);
 #endif
+        }
+    }
+    else if (bcs) {
+        wait_bc_reduction(*bcs);
     }
 
     for (int ilev = 0; ilev < nlevs; ++ilev)
@@ -3675,6 +4419,116 @@ Gravity::solve_phi_with_mlmg (int crse_level, int fine_level,
                                   crse_bcdata, rel_eps, abs_eps);
 }
 
+bool
+Gravity::use_fft_solve (int crse_level, int fine_level) const
+{
+    return gravity::level0_solver == "FFT" && crse_level == 0 && fine_level == 0;
+}
+
+#ifdef AMREX_USE_FFT
+void
+Gravity::solve_phi_with_fft (MultiFab& phi,
+                             const MultiFab& rhs,
+                             const Vector<MultiFab*>& grad_phi)
+{
+    BL_PROFILE("Gravity::solve_phi_with_fft()");
+
+    const Real strt = ParallelDescriptor::second();
+
+    const Geometry& geom = parent->Geom(0);
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (mlmg_lobc[idim] != MLLinOp::BCType::Dirichlet ||
+            mlmg_hibc[idim] != MLLinOp::BCType::Dirichlet) {
+            amrex::Abort("gravity.level0_solver = FFT needs isolated boundaries on every side of the domain");
+        }
+    }
+
+    if (!fft_solver) {
+
+        // We solve on the domain grown by one zone (with no mass in
+        // the extra zones) so that we get phi in the ghost zones on
+        // the domain boundary too.
+
+        const Box domain = amrex::grow(geom.Domain(), 1);
+
+        fft_ba = BoxArray(domain);
+        fft_ba.maxSize(parent->maxGridSize(0));
+        fft_dm = DistributionMapping(fft_ba);
+
+        fft_solver = std::make_unique<FFT::OpenBCSolver<Real> >(domain);
+
+        const auto dx = geom.CellSizeArray();
+        const Real dV = dx[0] * dx[1] * dx[2];
+
+        // phi = -G int rho / r dV = -(1 / 4 pi) int rhs / r dV.  For the
+        // zone's own mass we use the potential at the center of a
+        // uniform cube, -G rho * 2.3800774 h**2, with h**3 = dV.
+
+        const Real fac = -dV / (4.0_rt * M_PI);
+        const Real self = -2.3800774_rt * std::cbrt(dV * dV) / (4.0_rt * M_PI);
+
+        const auto lo = amrex::lbound(domain);
+
+        fft_solver->setGreensFunction([=] AMREX_GPU_DEVICE (int i, int j, int k) -> Real
+        {
+            if (i == lo.x && j == lo.y && k == lo.z) {
+                return self;
+            }
+
+            const Real x = static_cast<Real>(i - lo.x) * dx[0];
+            const Real y = static_cast<Real>(j - lo.y) * dx[1];
+            const Real z = static_cast<Real>(k - lo.z) * dx[2];
+
+            return fac / std::sqrt(x * x + y * y + z * z);
+        });
+    }
+
+    MultiFab rhs_fft(fft_ba, fft_dm, 1, 0);
+    rhs_fft.setVal(0.0);
+    rhs_fft.ParallelCopy(rhs, 0, 0, 1);
+
+    MultiFab phi_fft(fft_ba, fft_dm, 1, 0);
+
+    fft_solver->solve(phi_fft, rhs_fft);
+
+    phi.ParallelCopy(phi_fft, 0, 0, 1, IntVect(0), IntVect(std::min(phi.nGrow(), 1)));
+
+    // The gradient on the faces, as MLMG's getGradSolution gives it
+
+    const auto dxinv = geom.InvCellSizeArray();
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+
+        const IntVect off = IntVect::TheDimensionVector(idim);
+        const Real dxi = dxinv[idim];
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(*grad_phi[idim], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& nbx = mfi.tilebox();
+
+            auto p = phi.const_array(mfi);
+            auto gp = grad_phi[idim]->array(mfi);
+
+            amrex::ParallelFor(nbx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+            {
+                gp(i,j,k) = (p(i,j,k) - p(i-off[0],j-off[1],k-off[2])) * dxi;
+            });
+        }
+    }
+
+    if (gravity::verbose > 0) {
+        Real end = ParallelDescriptor::second() - strt;
+        ParallelDescriptor::ReduceRealMax(end, ParallelDescriptor::IOProcessorNumber());
+        amrex::Print() << "Gravity: FFT solve for level 0 took " << end << " seconds" << std::endl;
+    }
+}
+#endif
+
 void
 Gravity::solve_for_delta_phi(int crse_level, int fine_level,
                              const Vector<MultiFab*>& rhs,
@@ -3712,7 +4566,7 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
                                  const amrex::Vector<std::array<amrex::MultiFab*,AMREX_SPACEDIM> >& grad_phi,
                                  const amrex::Vector<amrex::MultiFab*>& res,
                                  const amrex::MultiFab* const crse_bcdata,
-                                 amrex::Real rel_eps, amrex::Real abs_eps) const
+                                 amrex::Real rel_eps, amrex::Real abs_eps)
 {
     BL_PROFILE("Gravity::actual_solve_with_mlmg()");
 
@@ -3730,14 +4584,54 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
         dmv.push_back(rhs[ilev]->DistributionMap());
     }
 
-    LPInfo info;
-    info.setAgglomeration(gravity::mlmg_agglomeration);
-    info.setConsolidation(gravity::mlmg_consolidation);
+    // Building the operator (and with it the coarsened grids, and the
+    // agglomerated / consolidated bottom levels) is a large part of
+    // the cost of a solve, and it only depends on the grids. So we
+    // look for one we built earlier for the same levels and grids.
+
+    MLMGCacheEntry* entry = nullptr;
+
+    if (gravity::mlmg_reuse_operators) {
+        for (auto& e : mlmg_cache) {
+            if (e->crse_level == crse_level && e->fine_level == fine_level &&
+                e->ba == bav && e->dm == dmv) {
+                entry = e.get();
+                break;
+            }
+        }
+    }
+
+    std::unique_ptr<MLMGCacheEntry> new_entry;
+
+    if (entry == nullptr) {
+
+        new_entry = std::make_unique<MLMGCacheEntry>();
+        entry = new_entry.get();
+
+        entry->crse_level = crse_level;
+        entry->fine_level = fine_level;
+        entry->ba = bav;
+        entry->dm = dmv;
+
+        LPInfo info;
+        info.setAgglomeration(gravity::mlmg_agglomeration);
+        info.setConsolidation(gravity::mlmg_consolidation);
+
+        entry->op = std::make_unique<MLPoisson>(gmv, bav, dmv, info);
+
+        // BC
+        entry->op->setDomainBC(mlmg_lobc, mlmg_hibc);
+
+        entry->mlmg = std::make_unique<MLMG>(*entry->op);
 
-    MLPoisson mlpoisson(gmv, bav, dmv, info);
+    }
+    else if (gravity::verbose > 1) {
+        amrex::Print() << " ... reusing the MLMG solver for levels "
+                       << crse_level << " to " << fine_level << '\n';
+    }
+
+    MLPoisson& mlpoisson = *entry->op;
 
-    // BC
-    mlpoisson.setDomainBC(mlmg_lobc, mlmg_hibc);
     if (mlpoisson.needsCoarseDataForBC())
     {
         mlpoisson.setCoarseFineBC(crse_bcdata, parent->refRatio(crse_level-1)[0]);
@@ -3748,7 +4642,7 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
         mlpoisson.setLevelBC(ilev, phi[ilev]);
     }
 
-    MLMG mlmg(mlpoisson);
+    MLMG& mlmg = *entry->mlmg;
     mlmg.setVerbose(gravity::verbose - 1); // With normal verbosity we don't want MLMG information
     if (crse_level == 0) {
         mlmg.setMaxFmgIter(gravity::mlmg_max_fmg_iter);
@@ -3761,13 +4655,25 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
 
     if (!grad_phi.empty())
     {
-        if (!gmv[0].isAllPeriodic()) {
+        // Measure the relative tolerance against the RHS rather than
+        // the initial residual. Otherwise, a better initial guess would
+        // only tighten the target and could not save any V-cycles. If
+        // the initial residual already meets the tolerance, MLMG then
+        // returns without doing any V-cycles.
+
+        if (!gmv[0].isAllPeriodic() || gravity::phi_guess_order > 0) {
             mlmg.setAlwaysUseBNorm(true);
         }
 
         mlmg.setNSolve(gravity::mlmg_nsolve);
         final_resnorm = mlmg.solve(phi, rhs, rel_eps, abs_eps);
 
+        if (gravity::verbose > 0) {
+            amrex::Print() << "Gravity: MLMG solve for levels " << crse_level << " to " << fine_level
+                           << " took " << mlmg.getNumIters() << " V-cycles, final residual = "
+                           << final_resnorm << std::endl;
+        }
+
         mlmg.getGradSolution(grad_phi);
     }
     else if (!res.empty())
@@ -3775,5 +4681,9 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
         mlmg.compResidual(res, phi, rhs);
     }
 
+    if (new_entry && gravity::mlmg_reuse_operators) {
+        mlmg_cache.push_back(std::move(new_entry));
+    }
+
     return final_resnorm;
 }
@@ -0,0 +1,255 @@
+#include <cmath>
+
+#include <AMReX_BLassert.H>
+
+#include <fundamental_constants.H>
+
+#include <gravity_tree.H>
+
+using namespace amrex;
+
+void
+GravityTree::addBox (const Box& bx, Array4<Real const> const& mass, const Geometry& geom)
+{
+    const int root = build(bx, mass, geom);
+
+    if (root >= 0) {
+        roots.push_back(root);
+    }
+}
+
+int
+GravityTree::build (const Box& bx, Array4<Real const> const& mass, const Geometry& geom)
+{
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+
+    // the physical extent of the box
+
+    Real blo[3] = {0.0_rt};
+    Real bhi[3] = {0.0_rt};
+
+    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+        blo[n] = problo[n] + static_cast<Real>(bx.smallEnd(n)) * dx[n];
+        bhi[n] = problo[n] + static_cast<Real>(bx.bigEnd(n) + 1) * dx[n];
+    }
+
+    const int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+
+    Node node;
+
+    if (bx.numPts() <= leaf_zones) {
+
+        node.zone_lo = static_cast<int>(zones.size());
+
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
+
+        for (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    if (mass(i,j,k) == 0.0_rt) {
+                        continue;
+                    }
+
+                    Zone z{};
+                    const int idx[3] = {i, j, k};
+                    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                        z.loc[n] = problo[n] + (static_cast<Real>(idx[n]) + 0.5_rt) * dx[n];
+                    }
+                    z.mass = mass(i,j,k);
+
+                    zones.push_back(z);
+                }
+            }
+        }
+
+        node.zone_hi = static_cast<int>(zones.size());
+
+        if (node.zone_hi == node.zone_lo) {
+            nodes.pop_back();
+            return -1;
+        }
+
+        for (int z = node.zone_lo; z < node.zone_hi; ++z) {
+            node.mass += zones[z].mass;
+        }
+
+        // The center of mass.  If the mass is not positive (which can
+        // only happen if the density is not), we expand about the
+        // center of the box instead and ignore the dipole moment.
+
+        for (int n = 0; n < 3; ++n) {
+            if (node.mass > 0.0_rt) {
+                for (int z = node.zone_lo; z < node.zone_hi; ++z) {
+                    node.com[n] += zones[z].mass * zones[z].loc[n];
+                }
+                node.com[n] /= node.mass;
+            } else {
+                node.com[n] = 0.5_rt * (blo[n] + bhi[n]);
+            }
+        }
+
+        for (int z = node.zone_lo; z < node.zone_hi; ++z) {
+            const Real d[3] = {zones[z].loc[0] - node.com[0],
+                               zones[z].loc[1] - node.com[1],
+                               zones[z].loc[2] - node.com[2]};
+            const Real d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+
+            node.quad[0] += zones[z].mass * (3.0_rt * d[0] * d[0] - d2);
+            node.quad[1] += zones[z].mass * (3.0_rt * d[1] * d[1] - d2);
+            node.quad[2] += zones[z].mass * (3.0_rt * d[2] * d[2] - d2);
+            node.quad[3] += zones[z].mass * 3.0_rt * d[0] * d[1];
+            node.quad[4] += zones[z].mass * 3.0_rt * d[0] * d[2];
+            node.quad[5] += zones[z].mass * 3.0_rt * d[1] * d[2];
+        }
+
+    }
+    else {
+
+        // bisect the box in every direction that is longer than one zone
+
+        Vector<Box> sub{bx};
+
+        for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+            if (bx.length(n) < 2) {
+                continue;
+            }
+
+            const int nsub = static_cast<int>(sub.size());
+            for (int s = 0; s < nsub; ++s) {
+                Box upper = sub[s].chop(n, bx.smallEnd(n) + bx.length(n) / 2);
+                sub.push_back(upper);
+            }
+        }
+
+        for (const auto& b : sub) {
+            const int c = build(b, mass, geom);
+            if (c >= 0) {
+                node.child[node.nchild++] = c;
+            }
+        }
+
+        if (node.nchild == 0) {
+            // all of the children were empty and have removed
+            // themselves, so this is the last node again
+            nodes.pop_back();
+            return -1;
+        }
+
+        for (int c = 0; c < node.nchild; ++c) {
+            node.mass += nodes[node.child[c]].mass;
+        }
+
+        for (int n = 0; n < 3; ++n) {
+            if (node.mass > 0.0_rt) {
+                for (int c = 0; c < node.nchild; ++c) {
+                    node.com[n] += nodes[node.child[c]].mass * nodes[node.child[c]].com[n];
+                }
+                node.com[n] /= node.mass;
+            } else {
+                node.com[n] = 0.5_rt * (blo[n] + bhi[n]);
+            }
+        }
+
+        // shift the children's quadrupoles to our center of mass (the
+        // children's dipoles about their own centers of mass vanish)
+
+        for (int c = 0; c < node.nchild; ++c) {
+            const Node& ch = nodes[node.child[c]];
+
+            const Real d[3] = {ch.com[0] - node.com[0],
+                               ch.com[1] - node.com[1],
+                               ch.com[2] - node.com[2]};
+            const Real d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+
+            node.quad[0] += ch.quad[0] + ch.mass * (3.0_rt * d[0] * d[0] - d2);
+            node.quad[1] += ch.quad[1] + ch.mass * (3.0_rt * d[1] * d[1] - d2);
+            node.quad[2] += ch.quad[2] + ch.mass * (3.0_rt * d[2] * d[2] - d2);
+            node.quad[3] += ch.quad[3] + ch.mass * 3.0_rt * d[0] * d[1];
+            node.quad[4] += ch.quad[4] + ch.mass * 3.0_rt * d[0] * d[2];
+            node.quad[5] += ch.quad[5] + ch.mass * 3.0_rt * d[1] * d[2];
+        }
+
+    }
+
+    // the enclosing radius is the distance to the farthest corner of
+    // the box
+
+    node.size2 = 0.0_rt;
+    for (int n = 0; n < 3; ++n) {
+        const Real d = amrex::max(std::abs(node.com[n] - blo[n]), std::abs(bhi[n] - node.com[n]));
+        node.size2 += d * d;
+    }
+
+    nodes[index] = node;
+
+    return index;
+}
+
+Real
+GravityTree::potential (const GpuArray<Real, 3>& loc) const
+{
+    const Real theta2 = theta * theta;
+
+    Real phi = 0.0_rt;
+
+    int stack[8 * max_depth];
+
+    for (int root : roots) {
+
+        int nstack = 0;
+        stack[nstack++] = root;
+
+        while (nstack > 0) {
+
+            const Node& node = nodes[stack[--nstack]];
+
+            const Real d[3] = {loc[0] - node.com[0],
+                               loc[1] - node.com[1],
+                               loc[2] - node.com[2]};
+            const Real d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+
+            if (node.size2 < theta2 * d2) {
+
+                // far enough away to use the multipole expansion
+
+                const Real rinv = 1.0_rt / std::sqrt(d2);
+                const Real rinv2 = rinv * rinv;
+
+                const Real qdd = node.quad[0] * d[0] * d[0] +
+                                 node.quad[1] * d[1] * d[1] +
+                                 node.quad[2] * d[2] * d[2] +
+                                 2.0_rt * (node.quad[3] * d[0] * d[1] +
+                                           node.quad[4] * d[0] * d[2] +
+                                           node.quad[5] * d[1] * d[2]);
+
+                phi -= C::Gconst * rinv * (node.mass + 0.5_rt * qdd * rinv2 * rinv2);
+
+            }
+            else if (node.nchild == 0) {
+
+                for (int z = node.zone_lo; z < node.zone_hi; ++z) {
+                    const Real r = std::sqrt((loc[0] - zones[z].loc[0]) * (loc[0] - zones[z].loc[0]) +
+                                             (loc[1] - zones[z].loc[1]) * (loc[1] - zones[z].loc[1]) +
+                                             (loc[2] - zones[z].loc[2]) * (loc[2] - zones[z].loc[2]));
+
+                    phi -= C::Gconst * zones[z].mass / r;
+                }
+
+            }
+            else {
+
+                AMREX_ASSERT(nstack + node.nchild <= 8 * max_depth);
+
+                for (int c = 0; c < node.nchild; ++c) {
+                    stack[nstack++] = node.child[c];
+                }
+
+            }
+        }
+    }
+
+    return phi;
+}
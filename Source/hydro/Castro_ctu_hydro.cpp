@@ -10,9 +10,32 @@
 #endif
 
 #include <advection_util.H>
+#include <ctu_scratch.H>
 
 using namespace amrex;
 
+Vector<std::unique_ptr<CTUScratch>> Castro::ctu_scratch;
+
+CTUScratch&
+Castro::get_ctu_scratch ()
+{
+    const int tid = OpenMP::get_thread_num();
+
+    AMREX_ASSERT(tid < static_cast<int>(ctu_scratch.size()));
+
+    if (ctu_scratch[tid] == nullptr) {
+        ctu_scratch[tid] = std::make_unique<CTUScratch>();
+    }
+
+    return *ctu_scratch[tid];
+}
+
+void
+Castro::release_ctu_scratch ()
+{
+    ctu_scratch.clear();
+}
+
 advance_status
 Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-convert-member-functions-to-static)
 {
@@ -125,11 +148,38 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
    }
 #endif
 
+  // The largest amount of scratch memory used by any one thread,
+  // and the number of zones in the largest tile.
+
+  Long scratch_bytes = 0;
+  Long largest_tile_zones = 0;
+
+  IntVect tile_size = hydro_tile_size;
+
+#ifndef AMREX_USE_GPU
+  const bool autotune_tile_size = castro::hydro_tile_size_autotune == 1;
+
+  if (autotune_tile_size) {
+      tile_size = hydro_tile_size_autotune_begin();
+  }
+
+  // Make sure that every thread has a slot for its workspace before
+  // we enter the threaded region.
+
+  if (ctu_scratch.size() < static_cast<std::size_t>(OpenMP::get_max_threads())) {
+      ctu_scratch.resize(OpenMP::get_max_threads());
+  }
+#endif
+
+  // the autotuner only times the MFIter loop itself
+
+  const Real loop_strt_time = ParallelDescriptor::second();
+
 #ifdef _OPENMP
 #ifdef RADIATION
-#pragma omp parallel reduction(max:nstep_fsp)
+#pragma omp parallel reduction(max:nstep_fsp,scratch_bytes,largest_tile_zones)
 #else
-#pragma omp parallel
+#pragma omp parallel reduction(max:scratch_bytes,largest_tile_zones)
 #endif
 #endif
   {
@@ -138,59 +188,72 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
     int priv_nstep_fsp = -1;
 #endif
 
-    // Declare local storage now. This should be done outside the
-    // MFIter loop, and then we will resize the Fabs in each MFIter
-    // loop iteration. We use the async arenato ensure that their
-    // memory is saved until it is no longer needed (only relevant for
-    // the asynchronous case, usually on GPUs).
+    // Get the local storage now, outside the MFIter loop; the Fabs
+    // are resized in each MFIter loop iteration.  On GPUs we use the
+    // async arena to ensure that their memory is saved until it is no
+    // longer needed.  On CPUs each thread reuses its own persistent
+    // workspace, so the Fabs only ever grow to the largest tile.
 
-    FArrayBox shk(The_Async_Arena());
-    FArrayBox q(The_Async_Arena()), qaux(The_Async_Arena());
-    FArrayBox rho_inv(The_Async_Arena());
-    FArrayBox src_q(The_Async_Arena());
-    FArrayBox qxm(The_Async_Arena()), qxp(The_Async_Arena());
+#ifdef AMREX_USE_GPU
+    CTUScratch local_scratch(The_Async_Arena());
+    CTUScratch& scratch = local_scratch;
+#else
+    CTUScratch& scratch = get_ctu_scratch();
+#endif
+
+    FArrayBox& shk = scratch.shk;
+    FArrayBox& q = scratch.q;
+    FArrayBox& qaux = scratch.qaux;
+    FArrayBox& rho_inv = scratch.rho_inv;
+    FArrayBox& src_q = scratch.src_q;
+    FArrayBox& qxm = scratch.qxm;
+    FArrayBox& qxp = scratch.qxp;
 #if AMREX_SPACEDIM >= 2
-    FArrayBox qym(The_Async_Arena()), qyp(The_Async_Arena());
+    FArrayBox& qym = scratch.qym;
+    FArrayBox& qyp = scratch.qyp;
 #endif
 #if AMREX_SPACEDIM == 3
-    FArrayBox qzm(The_Async_Arena()), qzp(The_Async_Arena());
+    FArrayBox& qzm = scratch.qzm;
+    FArrayBox& qzp = scratch.qzp;
 #endif
-    FArrayBox div(The_Async_Arena());
+    FArrayBox& div = scratch.div;
 #if AMREX_SPACEDIM >= 2
-    FArrayBox ftmp1(The_Async_Arena()), ftmp2(The_Async_Arena());
+    FArrayBox& ftmp1 = scratch.ftmp1;
+    FArrayBox& ftmp2 = scratch.ftmp2;
 #ifdef RADIATION
-    FArrayBox rftmp1(The_Async_Arena()), rftmp2(The_Async_Arena());
+    FArrayBox& rftmp1 = scratch.rftmp1;
+    FArrayBox& rftmp2 = scratch.rftmp2;
 #endif
-    FArrayBox qgdnvtmp1(The_Async_Arena()), qgdnvtmp2(The_Async_Arena());
-    FArrayBox ql(The_Async_Arena()), qr(The_Async_Arena());
+    FArrayBox& qgdnvtmp1 = scratch.qgdnvtmp1;
+    FArrayBox& qgdnvtmp2 = scratch.qgdnvtmp2;
 #endif
-    Vector<FArrayBox> flux, qe;
-    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-        flux.push_back(FArrayBox(The_Async_Arena()));
-        qe.push_back(FArrayBox(The_Async_Arena()));
-    }
+#if AMREX_SPACEDIM == 2
+    FArrayBox& ql = scratch.ql;
+    FArrayBox& qr = scratch.qr;
+#endif
+    Vector<FArrayBox>& flux = scratch.flux;
+    Vector<FArrayBox>& qe = scratch.qe;
 
 #ifdef RADIATION
-    Vector<FArrayBox> rad_flux;
-    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-        rad_flux.push_back(FArrayBox(The_Async_Arena()));
-    }
+    Vector<FArrayBox>& rad_flux = scratch.rad_flux;
 #endif
 #if AMREX_SPACEDIM <= 2
-    FArrayBox pradial(The_Async_Arena());
+    FArrayBox& pradial = scratch.pradial;
 #endif
 #if AMREX_SPACEDIM == 3
-    FArrayBox qmyx(The_Async_Arena()), qpyx(The_Async_Arena());
-    FArrayBox qmzx(The_Async_Arena()), qpzx(The_Async_Arena());
-    FArrayBox qmxy(The_Async_Arena()), qpxy(The_Async_Arena());
-    FArrayBox qmzy(The_Async_Arena()), qpzy(The_Async_Arena());
-    FArrayBox qmxz(The_Async_Arena()), qpxz(The_Async_Arena());
-    FArrayBox qmyz(The_Async_Arena()), qpyz(The_Async_Arena());
+    FArrayBox& qmyx = scratch.qmyx;
+    FArrayBox& qpyx = scratch.qpyx;
+    FArrayBox& qmzx = scratch.qmzx;
+    FArrayBox& qpzx = scratch.qpzx;
+    FArrayBox& qmxy = scratch.qmxy;
+    FArrayBox& qpxy = scratch.qpxy;
+    FArrayBox& qmzy = scratch.qmzy;
+    FArrayBox& qpzy = scratch.qpzy;
 #endif
 
     MultiFab& old_source = get_old_data(Source_Type);
 
-    for (MFIter mfi(S_new, hydro_tile_size); mfi.isValid(); ++mfi) {
+    for (MFIter mfi(S_new, tile_size); mfi.isValid(); ++mfi) {
 
       // the valid region box
       const Box& bx = mfi.tilebox();
@@ -508,6 +571,9 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
       fab_size += qgdnvtmp2.nBytes();
 #endif
 
+#endif
+
+#if AMREX_SPACEDIM == 2
       ql.resize(obx, NQ);
       auto ql_arr = ql.array();
       fab_size += ql.nBytes();
@@ -807,6 +873,106 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
 
       reset_edge_state_thermo(tzybx, qpzy.array());
 
+      //
+      // Use qz?, q?xy, q?yx to compute final z-flux
+      //
+      // This only needs the transverse states from the x- and y-sweeps,
+      // so we do it before the z-sweep.  That way the q?xy and q?yx
+      // states are dead before the q?xz and q?yz states are made, and
+      // at most 8 (rather than 12) transverse states are ever alive at
+      // once.
+      //
+
+      // compute F^{x|y}
+      // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), hi(3)+1]
+      const Box& cxybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
+
+      // ftmp1 = fxy
+      // rftmp1 = rfxy
+      // qgdnvtmp1 = qgdnvxy
+      cmpflx_plus_godunov(cxybx,
+                          qmxy_arr, qpxy_arr,
+                          ftmp1_arr,
+#ifdef RADIATION
+                          rftmp1_arr,
+#endif
+                          qgdnvtmp1_arr,
+                          qaux_arr, shk_arr,
+                          0, false);
+
+      // compute F^{y|x}
+      // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+dg(2), hi(3)+1]
+      const Box& cyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
+
+      // ftmp2 = fyx
+      // rftmp2 = rfyx
+      // qgdnvtmp2 = qgdnvyx
+      cmpflx_plus_godunov(cyxbx,
+                          qmyx_arr, qpyx_arr,
+                          ftmp2_arr,
+#ifdef RADIATION
+                          rftmp2_arr,
+#endif
+                          qgdnvtmp2_arr,
+                          qaux_arr, shk_arr,
+                          1, false);
+
+      // compute the corrected z interface states and fluxes
+      // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
+
+      {
+        // q?xy and q?yx are dead once F^{x|y} and F^{y|x} are made, so
+        // the corrected z interface states go into their memory
+        FArrayBox& ql = qmxy;
+        FArrayBox& qr = qpxy;
+
+        ql.resize(zbx, NQ);
+        auto ql_arr = ql.array();
+
+        qr.resize(zbx, NQ);
+        auto qr_arr = qr.array();
+
+        trans_final(zbx, 2, 0, 1,
+                    qzm_arr, ql_arr,
+                    qzp_arr, qr_arr,
+                    qaux_arr,
+                    ftmp1_arr,
+#ifdef RADIATION
+                    rftmp1_arr,
+#endif
+                    ftmp2_arr,
+#ifdef RADIATION
+                    rftmp2_arr,
+#endif
+                    qgdnvtmp1_arr,
+                    qgdnvtmp2_arr,
+                    hdtdx, hdtdy);
+
+        reset_edge_state_thermo(zbx, ql_arr);
+
+        reset_edge_state_thermo(zbx, qr_arr);
+
+#ifdef SIMPLIFIED_SDC
+#ifdef REACTIONS
+        add_sdc_source_to_states(zbx, 2, dt,
+                                 ql_arr, qr_arr, sdc_src_arr);
+#endif
+#endif
+
+        // compute the final z fluxes F^z
+        // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
+
+        cmpflx_plus_godunov(zbx,
+                            ql_arr, qr_arr,
+                            flux2_arr,
+#ifdef RADIATION
+                            rad_flux2_arr,
+#endif
+                            qez_arr,
+                            qaux_arr, shk_arr,
+                            2, false);
+      }
+
       // compute F^z
       // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)+1]
       const Box& czbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,1,0)));
@@ -827,13 +993,18 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
       // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
       const Box& txzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
 
+      // F^z is the last use of the z-interface states (the final
+      // z-flux has already been computed), so q?xz goes into their
+      // memory
+
+      FArrayBox& qmxz = qzm;
+      FArrayBox& qpxz = qzp;
+
       qmxz.resize(txzbx, NQ);
       auto qmxz_arr = qmxz.array();
-      fab_size += qmxz.nBytes();
 
       qpxz.resize(txzbx, NQ);
       auto qpxz_arr = qpxz.array();
-      fab_size += qpxz.nBytes();
 
       // ftmp1 = fz
       // rftmp1 = rfz
@@ -856,13 +1027,17 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
       // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
       const Box& tyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
 
+      // q?yx were only needed for the final z-flux, so q?yz reuses
+      // their memory
+
+      FArrayBox& qmyz = qmyx;
+      FArrayBox& qpyz = qpyx;
+
       qmyz.resize(tyzbx, NQ);
       auto qmyz_arr = qmyz.array();
-      fab_size += qmyz.nBytes();
 
       qpyz.resize(tyzbx, NQ);
       auto qpyz_arr = qpyz.array();
-      fab_size += qpyz.nBytes();
 
       // ftmp1 = fz
       // rftmp1 = rfz
@@ -882,7 +1057,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
 
       reset_edge_state_thermo(tyzbx, qpyz.array());
 
-      // we now have q?zx, q?yx, q?zy, q?xy, q?yz, q?xz
+      // we now have q?zx, q?zy, q?yz, q?xz
 
       //
       // Use qx?, q?yz, q?zy to compute final x-flux
@@ -925,43 +1100,55 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
       // compute the corrected x interface states and fluxes
       // [lo(1), lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)]
 
-      trans_final(xbx, 0, 1, 2,
-                  qxm_arr, ql_arr,
-                  qxp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp1_arr,
+      {
+        // likewise for q?yz and q?zy and the x interface states
+        FArrayBox& ql = qmyz;
+        FArrayBox& qr = qpyz;
+
+        ql.resize(xbx, NQ);
+        auto ql_arr = ql.array();
+
+        qr.resize(xbx, NQ);
+        auto qr_arr = qr.array();
+
+        trans_final(xbx, 0, 1, 2,
+                    qxm_arr, ql_arr,
+                    qxp_arr, qr_arr,
+                    qaux_arr,
+                    ftmp1_arr,
 #ifdef RADIATION
-                  rftmp1_arr,
+                    rftmp1_arr,
 #endif
-                  ftmp2_arr,
+                    ftmp2_arr,
 #ifdef RADIATION
-                  rftmp2_arr,
+                    rftmp2_arr,
 #endif
-                  qgdnvtmp1_arr,
-                  qgdnvtmp2_arr,
-                  hdtdy, hdtdz);
+                    qgdnvtmp1_arr,
+                    qgdnvtmp2_arr,
+                    hdtdy, hdtdz);
 
-      reset_edge_state_thermo(xbx, ql_arr);
+        reset_edge_state_thermo(xbx, ql_arr);
 
-      reset_edge_state_thermo(xbx, qr_arr);
+        reset_edge_state_thermo(xbx, qr_arr);
 
 #ifdef SIMPLIFIED_SDC
 #ifdef REACTIONS
-      add_sdc_source_to_states(xbx, 0, dt,
-                               ql_arr, qr_arr, sdc_src_arr);
+        add_sdc_source_to_states(xbx, 0, dt,
+                                 ql_arr, qr_arr, sdc_src_arr);
 #endif
 #endif
 
 
-      cmpflx_plus_godunov(xbx,
-                          ql_arr, qr_arr,
-                          flux0_arr,
+        cmpflx_plus_godunov(xbx,
+                            ql_arr, qr_arr,
+                            flux0_arr,
 #ifdef RADIATION
-                          rad_flux0_arr,
+                            rad_flux0_arr,
 #endif
-                          qex_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
+                            qex_arr,
+                            qaux_arr, shk_arr,
+                            0, false);
+      }
 
       //
       // Use qy?, q?zx, q?xz to compute final y-flux
@@ -1004,126 +1191,57 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
       // Compute the corrected y interface states and fluxes
       // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
 
-      trans_final(ybx, 1, 0, 2,
-                  qym_arr, ql_arr,
-                  qyp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp2_arr,
-#ifdef RADIATION
-                  rftmp2_arr,
-#endif
-                  ftmp1_arr,
-#ifdef RADIATION
-                  rftmp1_arr,
-#endif
-                  qgdnvtmp2_arr,
-                  qgdnvtmp1_arr,
-                  hdtdx, hdtdz);
-
-      reset_edge_state_thermo(ybx, ql_arr);
-
-      reset_edge_state_thermo(ybx, qr_arr);
-
-#ifdef SIMPLIFIED_SDC
-#ifdef REACTIONS
-      add_sdc_source_to_states(ybx, 1, dt,
-                               ql_arr, qr_arr, sdc_src_arr);
-#endif
-#endif
-
-
-      // Compute the final F^y
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
-      cmpflx_plus_godunov(ybx,
-                          ql_arr, qr_arr,
-                          flux1_arr,
-#ifdef RADIATION
-                          rad_flux1_arr,
-#endif
-                          qey_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
-
-      //
-      // Use qz?, q?xy, q?yx to compute final z-flux
-      //
-
-      // compute F^{x|y}
-      // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), hi(3)+1]
-      const Box& cxybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
-
-      // ftmp1 = fxy
-      // rftmp1 = rfxy
-      // qgdnvtmp1 = qgdnvxy
-      cmpflx_plus_godunov(cxybx,
-                          qmxy_arr, qpxy_arr,
-                          ftmp1_arr,
-#ifdef RADIATION
-                          rftmp1_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
-
-      // compute F^{y|x}
-      // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+dg(2), hi(3)+1]
-      const Box& cyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
+      {
+        // and for q?zx and q?xz and the y interface states
+        FArrayBox& ql = qmzx;
+        FArrayBox& qr = qpzx;
 
-      // ftmp2 = fyx
-      // rftmp2 = rfyx
-      // qgdnvtmp2 = qgdnvyx
-      cmpflx_plus_godunov(cyxbx,
-                          qmyx_arr, qpyx_arr,
-                          ftmp2_arr,
-#ifdef RADIATION
-                          rftmp2_arr,
-#endif
-                          qgdnvtmp2_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
+        ql.resize(ybx, NQ);
+        auto ql_arr = ql.array();
 
-      // compute the corrected z interface states and fluxes
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
+        qr.resize(ybx, NQ);
+        auto qr_arr = qr.array();
 
-      trans_final(zbx, 2, 0, 1,
-                  qzm_arr, ql_arr,
-                  qzp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp1_arr,
+        trans_final(ybx, 1, 0, 2,
+                    qym_arr, ql_arr,
+                    qyp_arr, qr_arr,
+                    qaux_arr,
+                    ftmp2_arr,
 #ifdef RADIATION
-                  rftmp1_arr,
+                    rftmp2_arr,
 #endif
-                  ftmp2_arr,
+                    ftmp1_arr,
 #ifdef RADIATION
-                  rftmp2_arr,
+                    rftmp1_arr,
 #endif
-                  qgdnvtmp1_arr,
-                  qgdnvtmp2_arr,
-                  hdtdx, hdtdy);
+                    qgdnvtmp2_arr,
+                    qgdnvtmp1_arr,
+                    hdtdx, hdtdz);
 
-      reset_edge_state_thermo(zbx, ql_arr);
+        reset_edge_state_thermo(ybx, ql_arr);
 
-      reset_edge_state_thermo(zbx, qr_arr);
+        reset_edge_state_thermo(ybx, qr_arr);
 
 #ifdef SIMPLIFIED_SDC
 #ifdef REACTIONS
-      add_sdc_source_to_states(zbx, 2, dt,
-                               ql_arr, qr_arr, sdc_src_arr);
+        add_sdc_source_to_states(ybx, 1, dt,
+                                 ql_arr, qr_arr, sdc_src_arr);
 #endif
 #endif
 
-      // compute the final z fluxes F^z
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
 
-      cmpflx_plus_godunov(zbx,
-                          ql_arr, qr_arr,
-                          flux2_arr,
+        // Compute the final F^y
+        // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
+        cmpflx_plus_godunov(ybx,
+                            ql_arr, qr_arr,
+                            flux1_arr,
 #ifdef RADIATION
-                          rad_flux2_arr,
+                            rad_flux1_arr,
 #endif
-                          qez_arr,
-                          qaux_arr, shk_arr,
-                          2, false);
+                            qey_arr,
+                            qaux_arr, shk_arr,
+                            1, false);
+      }
 
 #endif // 3-d
 
@@ -1419,10 +1537,33 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
       }
 #endif
 
+      scratch_bytes = std::max(scratch_bytes, static_cast<Long>(scratch.nBytes()));
+      largest_tile_zones = std::max(largest_tile_zones, bx.numPts());
+
     } // MFIter loop
 
   } // OMP loop
 
+#ifndef AMREX_USE_GPU
+  if (autotune_tile_size) {
+      hydro_tile_size_autotune_end(ParallelDescriptor::second() - loop_strt_time,
+                                   scratch_bytes, largest_tile_zones);
+  }
+#endif
+
+  if (verbose > 0) {
+#ifdef BL_LAZY
+    Lazy::QueueReduction( [=] () mutable {
+#endif
+      ParallelDescriptor::ReduceLongMax(scratch_bytes, ParallelDescriptor::IOProcessorNumber());
+
+      amrex::Print() << "... peak hydro scratch memory per thread on level " << level << ": "
+                     << static_cast<Real>(scratch_bytes) / (1024.0_rt * 1024.0_rt) << " MB" << std::endl << std::endl;
+#ifdef BL_LAZY
+    });
+#endif
+  }
+
 #ifdef RADIATION
   if (radiation->verbose>=1) {
 #ifdef BL_LAZY
@@ -1491,12 +1632,19 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
       const int IOProc   = ParallelDescriptor::IOProcessorNumber();
       Real      run_time = ParallelDescriptor::second() - strt_time;
 
+      // the zone throughput lets us compare the different
+      // reconstruction / Riemann solver kernel combinations directly
+
+      const Long num_zones = grids.numPts();
+
 #ifdef BL_LAZY
       Lazy::QueueReduction( [=] () mutable {
 #endif
         ParallelDescriptor::ReduceRealMax(run_time,IOProc);
 
-        amrex::Print() << "Castro::construct_ctu_hydro_source() time = " << run_time << " on level " << level << "\n" << "\n";
+        amrex::Print() << "Castro::construct_ctu_hydro_source() time = " << run_time << " on level " << level << "\n";
+        amrex::Print() << "    (" << static_cast<Real>(num_zones) / run_time << " zones / s with ppm_type = " << ppm_type
+                       << ", riemann_solver = " << riemann_solver << ", hybrid_riemann = " << hybrid_riemann << ")" << "\n" << "\n";
 #ifdef BL_LAZY
         });
 #endif
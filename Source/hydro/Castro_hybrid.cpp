@@ -2,6 +2,7 @@
 #include <Castro_util.H>
 
 #include <hybrid.H>
+#include <clean_state.H>
 
 using namespace amrex;
 
@@ -192,25 +193,7 @@ Castro::hybrid_to_linear_momentum(MultiFab& state_in, int ng)
         amrex::ParallelFor(bx,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            GpuArray<Real, 3> loc;
-
-            position(i, j, k, geomdata, loc);
-
-            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
-                loc[dir] -= problem::center[dir];
-
-            GpuArray<Real, 3> hybrid_mom;
-
-            for (int dir = 0; dir < 3; ++dir)
-                hybrid_mom[dir] = u(i,j,k,UMR+dir);
-
-            GpuArray<Real, 3> linear_mom;
-
-            hybrid_to_linear(loc, hybrid_mom, linear_mom);
-
-            for (int dir = 0; dir < 3; ++dir)
-                u(i,j,k,UMX+dir) = linear_mom[dir];
-
+            hybrid_to_linear_momentum_zone(i, j, k, u, geomdata);
         });
     }
 }
@@ -6,6 +6,7 @@
 
 #include <Castro_util.H>
 #include <advection_util.H>
+#include <clean_state.H>
 
 #ifdef HYBRID_MOMENTUM
 #include <hybrid.H>
@@ -590,94 +591,12 @@ Castro::do_enforce_minimum_density(const Box& bx,
                                    Array4<Real> const& state_arr,
                                    const int verbose_warnings) {
 
-#ifdef HYBRID_MOMENTUM
   GeometryData geomdata = geom.data();
-#endif
-
-  amrex::ignore_unused(verbose_warnings);
 
   amrex::ParallelFor(bx,
   [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
   {
-
-    if (state_arr(i,j,k,URHO) < small_dens) {
-
-#ifndef AMREX_USE_GPU
-      if (verbose_warnings > 1 ||
-          (verbose_warnings > 0 && state_arr(i,j,k,URHO) > castro::retry_small_density_cutoff)) {
-        std::cout << " " << std::endl;
-        if (state_arr(i,j,k,URHO) < 0.0_rt) {
-          std::cout << ">>> RESETTING NEG.  DENSITY AT " << i << ", " << j << ", " << k << std::endl;
-        }
-        else if (state_arr(i,j,k,URHO) == 0.0_rt) {
-          // If the density is *exactly* zero, that almost certainly means something has gone wrong,
-          // like we failed to properly fill the state data on grid creation.
-          amrex::Error("Density exactly zero at " + std::to_string(i) + ", " +
-                                                    std::to_string(j) + ", " +
-                                                    std::to_string(k));
-        }
-        else {
-          std::cout << ">>> RESETTING SMALL DENSITY AT " << i << ", " << j << ", " << k << std::endl;
-        }
-        std::cout << ">>> FROM " << state_arr(i,j,k,URHO) << " TO " << small_dens << std::endl;
-        std::cout << ">>> IN GRID " << bx << std::endl;
-        std::cout << " " << std::endl;
-      }
-#endif
-
-      for (int ipassive = 0; ipassive < npassive; ipassive++) {
-          const int n = upassmap(ipassive);
-          state_arr(i,j,k,n) *= (small_dens / state_arr(i,j,k,URHO));
-      }
-
-      eos_re_t eos_state;
-      eos_state.rho = small_dens;
-      eos_state.T = small_temp;
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = state_arr(i,j,k,UFS+n) / small_dens;
-      }
-#if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = state_arr(i,j,k,UFX+n) / small_dens;
-      }
-#endif
-
-      eos(eos_input_rt, eos_state);
-
-      state_arr(i,j,k,URHO ) = eos_state.rho;
-      state_arr(i,j,k,UTEMP) = eos_state.T;
-
-      state_arr(i,j,k,UMX) = 0.0_rt;
-      state_arr(i,j,k,UMY) = 0.0_rt;
-      state_arr(i,j,k,UMZ) = 0.0_rt;
-
-      state_arr(i,j,k,UEINT) = eos_state.rho * eos_state.e;
-      state_arr(i,j,k,UEDEN) = state_arr(i,j,k,UEINT);
-
-#ifdef HYBRID_MOMENTUM
-      GpuArray<Real, 3> loc;
-
-      position(i, j, k, geomdata, loc);
-
-      for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
-        loc[dir] -= problem::center[dir];
-      }
-
-      GpuArray<Real, 3> linear_mom;
-
-      for (int dir = 0; dir < 3; ++dir) {
-        linear_mom[dir] = state_arr(i,j,k,UMX+dir);
-      }
-
-      GpuArray<Real, 3> hybrid_mom;
-
-      linear_to_hybrid(loc, linear_mom, hybrid_mom);
-
-      for (int dir = 0; dir < 3; ++dir) {
-        state_arr(i,j,k,UMR+dir) = hybrid_mom[dir];
-      }
-#endif
-    }
+    enforce_min_density_zone(i, j, k, bx, state_arr, geomdata, verbose_warnings);
   });
 }
 
@@ -0,0 +1,203 @@
+#include <cmath>
+#include <limits>
+
+#include <Castro.H>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace amrex;
+
+namespace {
+
+    // Size in bytes of the level-n data cache, or 0 if we cannot find out.
+
+    Long cache_size (int n)
+    {
+        long bytes = 0;
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+        if (n == 2) {
+            bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        }
+        else if (n == 3) {
+            bytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        }
+#else
+        amrex::ignore_unused(n);
+#endif
+        return bytes > 0 ? static_cast<Long>(bytes) : 0;
+    }
+
+}
+
+Vector<IntVect>
+Castro::hydro_tile_size_candidates (Real bytes_per_zone, const IntVect& max_box_length)
+{
+    Vector<IntVect> candidates;
+
+    // A tile that is at least as large as the boxes behaves the same
+    // as no tiling, so clip every candidate to the box size to avoid
+    // timing the same thing twice.
+
+    auto add_candidate = [&] (IntVect tile) {
+        tile.min(max_box_length);
+        for (const auto& c : candidates) {
+            if (c == tile) {
+                return;
+            }
+        }
+        candidates.push_back(tile);
+    };
+
+    add_candidate(hydro_tile_size);
+
+#if AMREX_SPACEDIM >= 2
+    // We always keep the whole box in the (contiguous) x-direction and
+    // only vary the transverse tile extent.
+
+    Vector<int> transverse_sizes{4, 8, 16, 32, 64};
+
+    // Add the transverse extent for which the scratch data of a tile
+    // fits in the L2 cache, and the one for which it fits in this
+    // thread's share of the L3 cache.
+
+    const Real nx = static_cast<Real>(std::min(hydro_tile_size[0], max_box_length[0]));
+
+    if (bytes_per_zone > 0.0_rt) {
+        const Vector<Real> cache_bytes{static_cast<Real>(cache_size(2)),
+                                       static_cast<Real>(cache_size(3)) / static_cast<Real>(OpenMP::get_max_threads())};
+
+        for (Real bytes : cache_bytes) {
+            if (bytes <= 0.0_rt) {
+                continue;
+            }
+
+            const Real zones = bytes / (bytes_per_zone * nx);
+#if AMREX_SPACEDIM == 2
+            const int s = static_cast<int>(zones);
+#else
+            const int s = static_cast<int>(std::sqrt(zones));
+#endif
+            transverse_sizes.push_back(std::max(s, 1));
+        }
+    }
+
+    for (int s : transverse_sizes) {
+        IntVect tile = hydro_tile_size;
+        for (int idir = 1; idir < AMREX_SPACEDIM; ++idir) {
+            tile[idir] = s;
+        }
+        add_candidate(tile);
+    }
+#else
+    amrex::ignore_unused(bytes_per_zone);
+#endif
+
+    return candidates;
+}
+
+IntVect
+Castro::hydro_tile_size_autotune_begin ()
+{
+    if (static_cast<int>(hydro_tile_tuning.size()) <= level) {
+        hydro_tile_tuning.resize(level + 1);
+    }
+
+    auto& tuning = hydro_tile_tuning[level];
+
+    IntVect max_box_length{0};
+    for (int i = 0; i < grids.size(); ++i) {
+        max_box_length.max(grids[i].length());
+    }
+
+    // If the boxes on this level have grown beyond what we tuned for
+    // (e.g. after a regrid), start over.
+
+    if (!max_box_length.allLE(tuning.max_box_length)) {
+        if (tuning.locked && verbose) {
+            amrex::Print() << "... boxes on level " << level
+                           << " have grown, retuning the hydro tile size" << std::endl;
+        }
+        tuning = HydroTileTuning{};
+        tuning.max_box_length = max_box_length;
+    }
+
+    if (tuning.locked) {
+        return tuning.tile_size;
+    }
+
+    if (tuning.current < 0) {
+        // The first call is a warm-up: it grows the scratch space and
+        // tells us how much memory a zone needs.
+        return hydro_tile_size;
+    }
+
+    return tuning.candidates[tuning.current];
+}
+
+void
+Castro::hydro_tile_size_autotune_end (Real run_time, Long scratch_bytes, Long largest_tile_zones)
+{
+    auto& tuning = hydro_tile_tuning[level];
+
+    if (tuning.locked) {
+        return;
+    }
+
+    // Every rank needs to make the same choice, so use the slowest
+    // rank's time.
+
+    ParallelDescriptor::ReduceRealMax(run_time);
+
+    if (tuning.current < 0) {
+
+        ParallelDescriptor::ReduceLongMax(scratch_bytes);
+        ParallelDescriptor::ReduceLongMax(largest_tile_zones);
+
+        const Real bytes_per_zone = largest_tile_zones > 0 ?
+            static_cast<Real>(scratch_bytes) / static_cast<Real>(largest_tile_zones) : 0.0_rt;
+
+        tuning.candidates = hydro_tile_size_candidates(bytes_per_zone, tuning.max_box_length);
+        tuning.zones_per_sec.assign(tuning.candidates.size(), 0.0_rt);
+
+        if (tuning.candidates.size() <= 1) {
+            // nothing to choose from
+            tuning.tile_size = tuning.candidates.empty() ? hydro_tile_size : tuning.candidates[0];
+            tuning.locked = true;
+        }
+        else {
+            tuning.current = 0;
+        }
+
+        return;
+    }
+
+    const Real zones_per_sec = static_cast<Real>(grids.numPts()) / std::max(run_time, std::numeric_limits<Real>::min());
+    tuning.zones_per_sec[tuning.current] = zones_per_sec;
+
+    if (verbose) {
+        amrex::Print() << "... hydro tile size " << tuning.candidates[tuning.current]
+                       << " on level " << level << ": " << zones_per_sec << " zones / s" << std::endl;
+    }
+
+    ++tuning.current;
+
+    if (tuning.current == static_cast<int>(tuning.candidates.size())) {
+
+        int best = 0;
+        for (int n = 1; n < static_cast<int>(tuning.candidates.size()); ++n) {
+            if (tuning.zones_per_sec[n] > tuning.zones_per_sec[best]) {
+                best = n;
+            }
+        }
+
+        tuning.tile_size = tuning.candidates[best];
+        tuning.locked = true;
+
+        if (verbose) {
+            amrex::Print() << "... locking in hydro tile size " << tuning.tile_size
+                           << " on level " << level << std::endl << std::endl;
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include <Castro.H>
 
 #include <riemann_solvers.H>
+#include <riemann_batch.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -11,6 +12,129 @@
 #include <eos.H>
 using namespace amrex;
 
+namespace {
+
+    // the passive state on an interface with velocity un, given the
+    // left (Xl) and right (Xr) states
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    Real
+    upwind_passive (const Real un, const Real Xl, const Real Xr)
+    {
+        Real sgnm = std::copysign(1.0_rt, un);
+        if (un == 0.0_rt) {
+            sgnm = 0.0_rt;
+        }
+
+        Real fp = 0.5_rt*(1.0_rt + sgnm);
+        Real fm = 0.5_rt*(1.0_rt - sgnm);
+
+        return fp * Xl + fm * Xr;
+    }
+
+    // store the flux and Godunov state from the interface state found
+    // by one of the approximate state Riemann solvers, and upwind the
+    // passives (which are not part of qint)
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void
+    store_interface_flux (const int i, const int j, const int k, const int dir,
+                          const GeometryData& geomdata,
+                          const RiemannState& qint,
+                          Array4<Real> const& qm,
+                          Array4<Real> const& qp,
+                          Array4<Real> const& flx,
+#ifdef RADIATION
+                          Array4<Real> const& rflx,
+#endif
+                          Array4<Real> const& qgdnv, const bool store_full_state)
+    {
+        compute_flux_q(i, j, k, dir,
+                       geomdata,
+                       qint, flx,
+#ifdef RADIATION
+                       rflx,
+#endif
+                       qgdnv, store_full_state);
+
+        // the passives are always just upwinded, regardless of the solver
+
+        for (int ipassive = 0; ipassive < npassive; ipassive++) {
+            int nqp = qpassmap(ipassive);
+            int n  = upassmap(ipassive);
+
+            Real X_int = upwind_passive(qint.un, qm(i,j,k,nqp), qp(i,j,k,nqp));
+
+            flx(i,j,k,n) = flx(i,j,k,URHO) * X_int;
+
+            if (store_full_state) {
+                qgdnv(i,j,k,nqp) = X_int;
+            }
+        }
+    }
+
+    // correct the fluxes using an HLL scheme if we are in a shock
+    // (for hybrid_riemann)
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void
+    hybrid_hll_correction (const int i, const int j, const int k, const int dir,
+                           const int coord,
+                           Array4<Real> const& qm,
+                           Array4<Real> const& qp,
+                           Array4<Real const> const& qaux_arr,
+                           Array4<Real const> const& shk,
+                           Array4<Real> const& flx)
+    {
+        int is_shock = 0;
+
+        Real cl;
+        Real cr;
+
+        if (dir == 0) {
+            is_shock = static_cast<int>(shk(i-1,j,k) + shk(i,j,k));
+            cl = qaux_arr(i-1,j,k,QC);
+            cr = qaux_arr(i,j,k,QC);
+        } else if (dir == 1) {
+            is_shock = static_cast<int>(shk(i,j-1,k) + shk(i,j,k));
+            cl = qaux_arr(i,j-1,k,QC);
+            cr = qaux_arr(i,j,k,QC);
+        } else {
+            is_shock = static_cast<int>(shk(i,j,k-1) + shk(i,j,k));
+            cl = qaux_arr(i,j,k-1,QC);
+            cr = qaux_arr(i,j,k,QC);
+        }
+
+        if (is_shock >= 1) {
+
+            Real ql_zone[NQ];
+            Real qr_zone[NQ];
+            Real flx_zone[NUM_STATE];
+
+            for (int n = 0; n < NQ; n++) {
+                ql_zone[n] = qm(i,j,k,n);
+                qr_zone[n] = qp(i,j,k,n);
+            }
+
+            // pass in the current flux -- the
+            // HLL solver will overwrite this
+            // if necessary
+            for (int n = 0; n < NUM_STATE; n++) {
+                flx_zone[n] = flx(i,j,k,n);
+            }
+
+            HLL(ql_zone, qr_zone, cl, cr,
+                dir, coord,
+                flx_zone);
+
+            for (int n = 0; n < NUM_STATE; n++) {
+                flx(i,j,k,n) = flx_zone[n];
+            }
+        }
+    }
+
+}
+
 void
 Castro::cmpflx_plus_godunov(const Box& bx,
                             Array4<Real> const& qm,
@@ -65,63 +189,173 @@ Castro::cmpflx_plus_godunov(const Box& bx,
     const auto domlo = geom.Domain().loVect3d();
     const auto domhi = geom.Domain().hiVect3d();
 
-    amrex::ParallelFor(bx,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-    {
+    // the choice of Riemann solver, whether we apply the hybrid HLL
+    // correction in shocks, and the direction of the solve are the
+    // same for every interface in bx.  We make them compile-time
+    // options here, so a separate kernel is instantiated for each
+    // combination and the selection happens once, at launch, instead
+    // of per zone.  An out-of-range runtime value would silently
+    // launch nothing, so read_params rejects them.
+
+#if !defined(AMREX_USE_GPU) && !defined(RADIATION)
+    // on CPUs we can instead solve the approximate state Riemann
+    // problems riemann_batch_width interfaces at a time along x with
+    // the vectorized batch solvers.  Loading the states (which can
+    // call the EOS to fix bad thermodynamics) and computing the
+    // fluxes is still done one interface at a time, but the passives
+    // are upwinded for a whole row at once, reusing the interface
+    // velocities from the solve.
+
+    if (riemann_use_batch == 1 && (riemann_solver == 0 || riemann_solver == 1) && ppm_temp_fix != 2) {
+
+        constexpr int W = riemann_batch_width;
+
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
+
+        // the interface velocity of each interface in a row, used for
+        // upwinding the passives
+
+        Vector<Real> un_row(hi.x - lo.x + 1);
+        Real* AMREX_RESTRICT un = un_row.data();
+
+        for (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+                for (int i0 = lo.x; i0 <= hi.x; i0 += W) {
+
+                    const int nlanes = amrex::min(W, hi.x - i0 + 1);
+
+                    RiemannState ql[W];
+                    RiemannState qr[W];
+                    RiemannAux raux[W];
+
+                    RiemannStateBatch<W> ql_batch;
+                    RiemannStateBatch<W> qr_batch;
+                    RiemannStateBatch<W> qint_batch;
+                    RiemannAuxBatch<W> raux_batch;
+
+                    for (int l = 0; l < W; ++l) {
+                        if (l < nlanes) {
+                            load_input_states(i0 + l, j, k, idir,
+                                              qm, qp, qaux_arr,
+                                              ql[l], qr[l], raux[l]);
+                            raux[l].bnd_fac = riemann_bnd_fac(i0 + l, j, k, idir,
+                                                              special_bnd_lo, special_bnd_hi,
+                                                              domlo, domhi);
+                        } else {
+                            // pad a partial batch with the last interface
+                            ql[l] = ql[nlanes-1];
+                            qr[l] = qr[nlanes-1];
+                            raux[l] = raux[nlanes-1];
+                        }
+
+                        ql_batch.set(l, ql[l]);
+                        qr_batch.set(l, qr[l]);
+                        raux_batch.set(l, raux[l]);
+                    }
+
+                    bool converged[W];
+
+                    if (riemann_solver == 0) {
+                        riemannus_batch(ql_batch, qr_batch, raux_batch, qint_batch);
+                    } else {
+                        riemanncg_batch(ql_batch, qr_batch, raux_batch, qint_batch, converged);
+                    }
+
+                    for (int l = 0; l < nlanes; ++l) {
+                        const int i = i0 + l;
+
+                        RiemannState qint = qint_batch.get(l);
+
+                        if (riemann_solver == 1 && !converged[l]) {
+                            // let the scalar solver deal with the
+                            // non-convergence (see cg_blend)
+                            riemanncg(ql[l], qr[l], raux[l], qint);
+                        }
+
+                        compute_flux_q(i, j, k, idir,
+                                       geomdata,
+                                       qint, flx,
+                                       qgdnv, store_full_state);
+
+                        un[i-lo.x] = qint.un;
+                    }
+                }
 
+                // upwind all of the passives for the row, one species
+                // at a time
 
-        if (riemann_solver == 0 || riemann_solver == 1) {
-            // approximate state Riemann solvers
+                for (int ipassive = 0; ipassive < npassive; ipassive++) {
+                    const int nqp = qpassmap(ipassive);
+                    const int n  = upassmap(ipassive);
 
-            // first find the interface state on the current interface
+                    AMREX_PRAGMA_SIMD
+                    for (int i = lo.x; i <= hi.x; ++i) {
+                        const Real X_int = upwind_passive(un[i-lo.x], qm(i,j,k,nqp), qp(i,j,k,nqp));
 
-            RiemannState qint{};
+                        flx(i,j,k,n) = flx(i,j,k,URHO) * X_int;
 
-            riemann_state(i, j, k, idir,
-                          qm, qp, qaux_arr,
-                          qint,
-                          special_bnd_lo, special_bnd_hi,
-                          domlo, domhi);
+                        if (store_full_state) {
+                            qgdnv(i,j,k,nqp) = X_int;
+                        }
+                    }
+                }
 
-            // now use the interface state to compute and store the flux
+                // the HLL correction overwrites all of the fluxes, so
+                // it has to come after the passives
 
-            compute_flux_q(i, j, k, idir,
-                           geomdata,
-                           qint, flx,
-#ifdef RADIATION
-                           rflx,
-#endif
-                           qgdnv, store_full_state);
+                if (hybrid_riemann == 1) {
+                    for (int i = lo.x; i <= hi.x; ++i) {
+                        hybrid_hll_correction(i, j, k, idir, coord,
+                                              qm, qp, qaux_arr, shk, flx);
+                    }
+                }
+            }
+        }
 
-            // now do the passives -- we didn't include them in qint, qgdnv, or flux above
+        return;
+    }
+#endif
 
-            // the passives are always just upwinded, so we do that here
-            // regardless of the solver
+    amrex::ParallelFor(TypeList<CompileTimeOptions<0, 1, 2>,
+                                CompileTimeOptions<0, 1>,
+                                CompileTimeOptions<AMREX_D_DECL(0, 1, 2)>>{},
+                       {riemann_solver, hybrid_riemann, idir},
+                       bx,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k,
+                          auto solver_ctv, auto hybrid_ctv, auto idir_ctv) noexcept
+    {
+        constexpr int solver = decltype(solver_ctv)::value;
+        constexpr int hybrid = decltype(hybrid_ctv)::value;
+        constexpr int dir = decltype(idir_ctv)::value;
 
-            Real sgnm = std::copysign(1.0_rt, qint.un);
-            if (qint.un == 0.0_rt) {
-                sgnm = 0.0_rt;
-            }
+        if constexpr (solver == 0 || solver == 1) {
+            // approximate state Riemann solvers
 
-            Real fp = 0.5_rt*(1.0_rt + sgnm);
-            Real fm = 0.5_rt*(1.0_rt - sgnm);
+            // first find the interface state on the current interface
 
-            for (int ipassive = 0; ipassive < npassive; ipassive++) {
-                int nqp = qpassmap(ipassive);
-                int n  = upassmap(ipassive);
+            RiemannState qint{};
 
-                Real X_int = fp * qm(i,j,k,nqp) + fm * qp(i,j,k,nqp);
+            riemann_state<solver>(i, j, k, dir,
+                                  qm, qp, qaux_arr,
+                                  qint,
+                                  special_bnd_lo, special_bnd_hi,
+                                  domlo, domhi);
 
-                flx(i,j,k,n) = flx(i,j,k,URHO) * X_int;
+            // now use the interface state to compute and store the flux
 
-                if (store_full_state) {
-                    qgdnv(i,j,k,nqp) = X_int;
-                }
-            }
+            store_interface_flux(i, j, k, dir,
+                                 geomdata,
+                                 qint,
+                                 qm, qp, flx,
+#ifdef RADIATION
+                                 rflx,
+#endif
+                                 qgdnv, store_full_state);
 
-        } else if (riemann_solver == 2) {
+        } else {
             // HLLC
-            HLLC(i, j, k, idir,
+            HLLC(i, j, k, dir,
                  qm, qp,
                  qaux_arr,
                  flx,
@@ -129,69 +363,15 @@ Castro::cmpflx_plus_godunov(const Box& bx,
                  geomdata,
                  special_bnd_lo, special_bnd_hi,
                  domlo, domhi);
-
-#ifndef AMREX_USE_GPU
-        } else {
-            amrex::Error("ERROR: invalid value of riemann_solver");
-#endif
         }
 
-        if (hybrid_riemann == 1) {
+        if constexpr (hybrid == 1) {
             // correct the fluxes using an HLL scheme if we are in a shock
             // and doing the hybrid approach
 
-            int is_shock = 0;
-
-            if (idir == 0) {
-                is_shock = static_cast<int>(shk(i-1,j,k) + shk(i,j,k));
-            } else if (idir == 1) {
-                is_shock = static_cast<int>(shk(i,j-1,k) + shk(i,j,k));
-            } else {
-                is_shock = static_cast<int>(shk(i,j,k-1) + shk(i,j,k));
-            }
-
-            if (is_shock >= 1) {
-
-                Real cl;
-                Real cr;
-                if (idir == 0) {
-                    cl = qaux_arr(i-1,j,k,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                } else if (idir == 1) {
-                    cl = qaux_arr(i,j-1,k,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                } else {
-                    cl = qaux_arr(i,j,k-1,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                }
-
-                Real ql_zone[NQ];
-                Real qr_zone[NQ];
-                Real flx_zone[NUM_STATE];
-
-                for (int n = 0; n < NQ; n++) {
-                    ql_zone[n] = qm(i,j,k,n);
-                    qr_zone[n] = qp(i,j,k,n);
-                }
-
-                // pass in the current flux -- the
-                // HLL solver will overwrite this
-                // if necessary
-                for (int n = 0; n < NUM_STATE; n++) {
-                    flx_zone[n] = flx(i,j,k,n);
-                }
-
-                HLL(ql_zone, qr_zone, cl, cr,
-                    idir, coord,
-                    flx_zone);
-
-                for (int n = 0; n < NUM_STATE; n++) {
-                    flx(i,j,k,n) = flx_zone[n];
-                }
-            }
+            hybrid_hll_correction(i, j, k, dir, coord,
+                                  qm, qp, qaux_arr, shk, flx);
         }
     });
 
 }
-
-
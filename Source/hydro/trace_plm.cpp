@@ -96,9 +96,15 @@ Castro::trace_plm(const Box& bx, const int idir,
 
   // Compute left and right traced states
 
-  amrex::ParallelFor(bx,
-  [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+  // the well-balanced pressure reconstruction is a compile-time
+  // option of the kernel, so the zone loop does not branch on it
+
+  amrex::ParallelFor(TypeList<CompileTimeOptions<0, 1>>{},
+                     {static_cast<int>(use_pslope == 1)},
+                     bx,
+  [=] AMREX_GPU_DEVICE (int i, int j, int k, auto pslope_ctv) noexcept
   {
+    constexpr int do_pslope = decltype(pslope_ctv)::value;
 
     bool lo_bc_test = lo_symm && ((idir == 0 && i == domlo[0]) ||
                                   (idir == 1 && j == domlo[1]) ||
@@ -156,7 +162,7 @@ Castro::trace_plm(const Box& bx, const int idir,
     }
 
     // are we doing well-balanced?
-    if (use_pslope == 1) {
+    if constexpr (do_pslope == 1) {
 
       Real trho[nslp];
       Real src[nslp];
@@ -14,6 +14,151 @@
 using namespace amrex;
 using namespace reconstruction;
 
+namespace {
+
+    // the flattening coefficient applied to the parabolic profiles of
+    // zone (i, j, k)
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    Real
+    ppm_flattening (const int i, const int j, const int k,
+                    Array4<Real const> const& q_arr)
+    {
+        Real flat = 1.0;
+
+        if (castro::first_order_hydro) {
+            flat = 0.0;
+        }
+        else if (castro::use_flattening) {
+            flat = hydro::flatten(i, j, k, q_arr, QPRES);
+
+#ifdef RADIATION
+            flat *= hydro::flatten(i, j, k, q_arr, QPTOT);
+
+            if (radiation::flatten_pp_threshold > 0.0) {
+                if ( q_arr(i-1,j,k,QU) + q_arr(i,j-1,k,QV) + q_arr(i,j,k-1,QW) >
+                     q_arr(i+1,j,k,QU) + q_arr(i,j+1,k,QV) + q_arr(i,j,k+1,QW) ) {
+
+                    if (q_arr(i,j,k,QPRES) < radiation::flatten_pp_threshold * q_arr(i,j,k,QPTOT)) {
+                        flat = 0.0;
+                    }
+                }
+            }
+#endif
+        }
+
+        return flat;
+    }
+
+#ifndef AMREX_USE_GPU
+
+    // Reconstruct and trace all of the passives over bx.  This is the
+    // CPU version of the passive loop in trace_ppm: instead of
+    // rebuilding X = (rho X) / rho for every species in every zone, we
+    // sweep over x-rows of the box, load the flattening coefficient,
+    // the normal velocity, and the 1/rho stencil for the row once, and
+    // then do each species as a contiguous (and vectorizable) loop over
+    // the row.
+
+    void
+    trace_ppm_passives (const Box& bx, const Box& vbx, const int idir,
+                        const int QUN, const Real dtdx,
+                        Array4<Real const> const& U_arr,
+                        Array4<Real const> const& rho_inv_arr,
+                        Array4<Real const> const& q_arr,
+                        Array4<Real> const& qm,
+                        Array4<Real> const& qp)
+    {
+        if (npassive == 0) {
+            return;
+        }
+
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
+
+        const auto vlo = amrex::lbound(vbx);
+        const auto vhi = amrex::ubound(vbx);
+
+        const int nx = hi.x - lo.x + 1;
+
+        // offset of the stencil in each direction
+
+        const int di = (idir == 0) ? 1 : 0;
+        const int dj = (idir == 1) ? 1 : 0;
+        const int dk = (idir == 2) ? 1 : 0;
+
+        Vector<Real> flat_row(nx);
+        Vector<Real> un_row(nx);
+        Vector<Real> rho_inv_row(nslp * nx);
+
+        Real* AMREX_RESTRICT flat = flat_row.data();
+        Real* AMREX_RESTRICT un = un_row.data();
+        Real* AMREX_RESTRICT rho_inv = rho_inv_row.data();
+
+        for (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+
+                // which faces of this row are on the valid box -- in x
+                // this is decided per zone below
+
+                const bool do_plus = (idir == 1 && j >= vlo.y) || (idir == 2 && k >= vlo.z);
+                const bool do_minus = (idir == 1 && j <= vhi.y) || (idir == 2 && k <= vhi.z);
+
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    flat[i-lo.x] = ppm_flattening(i, j, k, q_arr);
+                    un[i-lo.x] = q_arr(i,j,k,QUN);
+                }
+
+                for (int m = 0; m < nslp; ++m) {
+                    const int off = m - i0;
+                    AMREX_PRAGMA_SIMD
+                    for (int i = lo.x; i <= hi.x; ++i) {
+                        rho_inv[m*nx + i-lo.x] = rho_inv_arr(i+off*di, j+off*dj, k+off*dk);
+                    }
+                }
+
+                for (int ipassive = 0; ipassive < npassive; ipassive++) {
+
+                    const int nc = upassmap(ipassive);
+                    const int n = qpassmap(ipassive);
+
+                    AMREX_PRAGMA_SIMD
+                    for (int i = lo.x; i <= hi.x; ++i) {
+
+                        Real s[nslp];
+                        for (int m = 0; m < nslp; ++m) {
+                            const int off = m - i0;
+                            s[m] = U_arr(i+off*di, j+off*dj, k+off*dk, nc) * rho_inv[m*nx + i-lo.x];
+                        }
+
+                        Real sm;
+                        Real sp;
+                        Real Ip_passive;
+                        Real Im_passive;
+
+                        ppm_reconstruct(s, flat[i-lo.x], sm, sp);
+                        ppm_int_profile_single(sm, sp, s[i0], un[i-lo.x], dtdx, Ip_passive, Im_passive);
+
+                        // plus state on face i, minus state on face
+                        // i+1 (see trace_ppm)
+
+                        if (do_plus || (idir == 0 && i >= vlo.x)) {
+                            qp(i,j,k,n) = Im_passive;
+                        }
+
+                        if (do_minus || (idir == 0 && i <= vhi.x)) {
+                            qm(i+di,j+dj,k+dk,n) = Ip_passive;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+#endif
+
+}
+
 void
 Castro::trace_ppm(const Box& bx,
                   const int idir,
@@ -143,10 +288,16 @@ Castro::trace_ppm(const Box& bx,
   Real lsmall_dens = small_dens;
   Real lsmall_pres = small_pres;
 
-  // Trace to left and right edges using upwind PPM
-  amrex::ParallelFor(bx,
-  [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+  // Trace to left and right edges using upwind PPM.  The
+  // well-balanced pressure reconstruction is a compile-time option of
+  // the kernel, so the zone loop does not branch on it
+
+  amrex::ParallelFor(TypeList<CompileTimeOptions<0, 1>>{},
+                     {static_cast<int>(use_pslope != 0)},
+                     bx,
+  [=] AMREX_GPU_DEVICE (int i, int j, int k, auto pslope_ctv) noexcept
   {
+    constexpr int do_pslope = decltype(pslope_ctv)::value;
 
 
     Real cc = qaux_arr(i,j,k,QC);
@@ -162,28 +313,7 @@ Castro::trace_ppm(const Box& bx,
     // integrals under the characteristic waves
     Real s[nslp];
 
-    Real flat = 1.0;
-
-    if (castro::first_order_hydro) {
-        flat = 0.0;
-    }
-    else if (castro::use_flattening) {
-        flat = hydro::flatten(i, j, k, q_arr, QPRES);
-
-#ifdef RADIATION
-        flat *= hydro::flatten(i, j, k, q_arr, QPTOT);
-
-        if (radiation::flatten_pp_threshold > 0.0) {
-            if ( q_arr(i-1,j,k,QU) + q_arr(i,j-1,k,QV) + q_arr(i,j,k-1,QW) >
-                 q_arr(i+1,j,k,QU) + q_arr(i,j+1,k,QV) + q_arr(i,j,k+1,QW) ) {
-
-                if (q_arr(i,j,k,QPRES) < radiation::flatten_pp_threshold * q_arr(i,j,k,QPTOT)) {
-                    flat = 0.0;
-                }
-            }
-        }
-#endif
-    }
+    Real flat = ppm_flattening(i, j, k, q_arr);
 
     Real sm;
     Real sp;
@@ -217,7 +347,7 @@ Castro::trace_ppm(const Box& bx,
 
     load_stencil(q_arr, idir, i, j, k, QPRES, s);
 
-    if (use_pslope) {
+    if constexpr (do_pslope == 1) {
         Real trho[nslp];
         Real src[nslp];
 
@@ -377,8 +507,11 @@ Castro::trace_ppm(const Box& bx,
 
     // do the passives separately
 
-    // the passive stuff is the same regardless of the tracing
+    // the passive stuff is the same regardless of the tracing.  On
+    // CPUs this is done after this loop by trace_ppm_passives, all
+    // species at once.
 
+#ifdef AMREX_USE_GPU
     Real Ip_passive;
     Real Im_passive;
 
@@ -418,6 +551,7 @@ Castro::trace_ppm(const Box& bx,
             qm(i,j,k+1,n) = Ip_passive;
         }
     }
+#endif
 
 
     // plus state on face i
@@ -634,6 +768,12 @@ Castro::trace_ppm(const Box& bx,
 #endif
 
   });
+
+#ifndef AMREX_USE_GPU
+  trace_ppm_passives(bx, vbx, idir, QUN, dtdx,
+                     U_arr, rho_inv_arr, q_arr,
+                     qm, qp);
+#endif
 }
 
 
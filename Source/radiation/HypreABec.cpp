@@ -7,6 +7,7 @@
 #include <rad_util.H>
 
 #include <iostream>
+#include <limits>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -205,6 +206,17 @@ HypreABec::HypreABec(const BoxArray& grids,
 
 HypreABec::~HypreABec()
 {
+  if (solver_is_setup) {
+    clearSolver();
+  }
+
+  for (int g = 0; g < static_cast<int>(group_setups.size()); ++g) {
+    selectGroup(g);
+    if (solver_is_setup) {
+      clearSolver();
+    }
+  }
+
   HYPRE_StructVectorDestroy(b);
   HYPRE_StructVectorDestroy(x);
 
@@ -915,6 +927,95 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 {
   BL_PROFILE("HypreABec::setupSolver");
 
+  loadMatrix();
+
+  reltol = _reltol;
+  abstol = _abstol; // may be used to change tolerance for solve
+
+  createSolver(maxiter);
+}
+
+bool HypreABec::updateSolver(Real _reltol, Real _abstol, int maxiter, Real reuse_tol,
+                             int igroup)
+{
+  BL_PROFILE("HypreABec::updateSolver");
+
+  selectGroup(amrex::max(igroup, 0));
+
+  const int size = AMREX_SPACEDIM + 1;
+
+  if (!mat_setup) {
+    mat_setup.reset(new MultiFab(acoefs->boxArray(), acoefs->DistributionMap(), size, 0));
+    mat_setup->setVal(0.0);
+  }
+
+  if (!mat_curr) {
+    mat_curr.reset(new MultiFab(acoefs->boxArray(), acoefs->DistributionMap(), size, 0));
+  }
+
+  Real change = loadMatrix();
+
+  if (solver_is_setup &&
+      _reltol == reltol && _abstol == abstol && maxiter == solver_maxiter &&
+      change <= reuse_tol) {
+    return false;
+  }
+
+  if (solver_is_setup) {
+    clearSolver();
+  }
+
+  reltol = _reltol;
+  abstol = _abstol;
+
+  createSolver(maxiter);
+
+  // the matrix we just loaded is the one the setup was done for
+
+  std::swap(mat_setup, mat_curr);
+
+  return true;
+}
+
+void HypreABec::selectGroup(int igroup)
+{
+  if (igroup == active_group) {
+    return;
+  }
+
+  if (igroup >= static_cast<int>(group_setups.size())) {
+    group_setups.resize(igroup + 1);
+  }
+
+  // The slot of the current group is empty while it is current, so
+  // swapping with it puts the current solver back and leaves us with
+  // nothing set up; swapping with the new group's slot then takes its
+  // solver out.
+
+  auto swap_setup = [&] (GroupSetup& gs)
+  {
+    std::swap(solver, gs.solver);
+    std::swap(precond, gs.precond);
+    std::swap(solver_is_setup, gs.is_setup);
+    std::swap(solver_maxiter, gs.maxiter);
+    std::swap(reltol, gs.reltol);
+    std::swap(abstol, gs.abstol);
+    std::swap(mat_setup, gs.mat_setup);
+  };
+
+  if (active_group >= 0) {
+    swap_setup(group_setups[active_group]);
+  }
+
+  swap_setup(group_setups[igroup]);
+
+  active_group = igroup;
+}
+
+Real HypreABec::loadMatrix()
+{
+  BL_PROFILE("HypreABec::loadMatrix");
+
   const BoxArray& grids = acoefs->boxArray();
 
   const int size = AMREX_SPACEDIM + 1;
@@ -926,6 +1027,10 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
     stencil_indices[i] = i;
   }
 
+  ReduceOps<ReduceOpMax, ReduceOpMax> reduce_op;
+  ReduceData<Real, Real> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
   BaseFab<GpuArray<Real, size>> matfab; // AoS indexing
   for (MFIter ai(*acoefs); ai.isValid(); ++ai) {
     i = ai.index();
@@ -987,6 +1092,29 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
     HYPRE_StructMatrixSetBoxValues(A, loV(reg), hiV(reg),
                                    size, stencil_indices, mat);
     Gpu::synchronize();
+
+    // keep a copy of the matrix, and measure how much it differs
+    // from the one the solver was set up for
+
+    if (mat_curr) {
+      auto m = matfab.const_array();
+      auto mc = (*mat_curr)[ai].array();
+      auto ms = (*mat_setup)[ai].const_array();
+
+      reduce_op.eval(reg, reduce_data,
+      [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+      {
+          Real dmax = 0.0_rt;
+          Real amax = 0.0_rt;
+          for (int n = 0; n < size; ++n) {
+              mc(i,j,k,n) = m(i,j,k)[n];
+              dmax = amrex::max(dmax, std::abs(m(i,j,k)[n] - ms(i,j,k,n)));
+              amax = amrex::max(amax, std::abs(ms(i,j,k,n)));
+          }
+          return {dmax, amax};
+      });
+      Gpu::synchronize();
+    }
   }
 
   HYPRE_StructMatrixAssemble(A);
@@ -994,8 +1122,22 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
   HYPRE_StructVectorAssemble(b); // currently a no-op
   HYPRE_StructVectorAssemble(x); // currently a no-op
 
-  reltol = _reltol;
-  abstol = _abstol; // may be used to change tolerance for solve
+  if (!mat_curr) {
+    return 0.0;
+  }
+
+  ReduceTuple hv = reduce_data.value();
+  Real change[2] = {amrex::get<0>(hv), amrex::get<1>(hv)};
+  ParallelDescriptor::ReduceRealMax(change, 2);
+
+  return (change[1] > 0.0) ? change[0] / change[1] : std::numeric_limits<Real>::max();
+}
+
+void HypreABec::createSolver(int maxiter)
+{
+  BL_PROFILE("HypreABec::createSolver");
+
+  solver_maxiter = maxiter;
 
   if (solver_flag == 0) {
     HYPRE_StructSMGCreate(MPI_COMM_WORLD, &solver);
@@ -1125,12 +1267,16 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
       amrex::Error("HypreABec: no such solver");
   }
   Gpu::synchronize();
+
+  solver_is_setup = true;
 }
 
 void HypreABec::clearSolver()
 {
   BL_PROFILE("HypreABec::clearSolver");
 
+  solver_is_setup = false;
+
   if (solver_flag == 0) {
     HYPRE_StructSMGDestroy(solver);
   }
@@ -1791,19 +1937,22 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
                        ? abstol / bnorm * std::sqrt(volume)
                        : reltol);
 
-    if (reltol_new > reltol) {
-      if (solver_flag == 0) {
-        HYPRE_StructSMGSetTol(solver, reltol_new);
-      }
-      else if(solver_flag == 1) {
-        HYPRE_StructPFMGSetTol(solver, reltol_new);
-      }
-      else if(solver_flag == 2) {
-        // nothing for this option
-      }
-      else if(solver_flag == 3 || solver_flag == 4) {
-        HYPRE_StructPCGSetTol(solver, reltol_new);
-      }
+    // The solver may be reused from an earlier solve, so we always
+    // set the tolerance rather than only loosening it.
+
+    reltol_new = std::max(reltol_new, reltol);
+
+    if (solver_flag == 0) {
+      HYPRE_StructSMGSetTol(solver, reltol_new);
+    }
+    else if(solver_flag == 1) {
+      HYPRE_StructPFMGSetTol(solver, reltol_new);
+    }
+    else if(solver_flag == 2) {
+      // nothing for this option
+    }
+    else if(solver_flag == 3 || solver_flag == 4) {
+      HYPRE_StructPCGSetTol(solver, reltol_new);
     }
   }
 
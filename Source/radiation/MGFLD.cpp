@@ -191,64 +191,17 @@ void Radiation::compute_coupling(MultiFab& coupT,
 }
 
 
-void Radiation::compute_etat(MultiFab& etaT, MultiFab& etaTz,
-                             MultiFab& eta1, MultiFab& djdT,
-                             const MultiFab& dkdT, const MultiFab& dedT,
-                             const MultiFab& Er_star, const MultiFab& rho,
-                             Real delta_t, Real ptc_tau)
-{
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (MFIter mfi(rho, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-        const Box& bx = mfi.tilebox();
-
-        auto etaT_arr = etaT[mfi].array();
-        auto etaTz_arr = etaTz[mfi].array();
-        auto eta1_arr = eta1[mfi].array();
-        auto djdT_arr = djdT[mfi].array();
-        auto dkdT_arr = dkdT[mfi].array();
-        auto dedT_arr = dedT[mfi].array();
-        auto Er_star_arr = Er_star[mfi].array();
-        auto rho_arr = rho[mfi].array();
-
-        amrex::ParallelFor(bx,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-            Real sigma = 1.e0_rt + ptc_tau;
-            Real cdt = C::c_light * delta_t;
-
-            Real dZdT[NGROUPS];
-            Real sumdZdT = 0.0_rt;
-            for (int g = 0; g < NGROUPS; ++g) {
-                dZdT[g] = djdT_arr(i,j,k,g) - dkdT_arr(i,j,k,g) * Er_star_arr(i,j,k,g);
-                sumdZdT += dZdT[g];
-            }
-
-            if (sumdZdT == 0.0_rt) {
-                sumdZdT = 1.e-50_rt;
-            }
-
-            Real foo = cdt * sumdZdT;
-            Real bar = sigma * rho_arr(i,j,k) * dedT_arr(i,j,k);
-            etaT_arr(i,j,k) = foo / (foo + bar);
-            etaTz_arr(i,j,k) = etaT_arr(i,j,k) / sumdZdT;
-            eta1_arr(i,j,k) = bar / (foo + bar);
-            for (int g = 0; g < NGROUPS; ++g) {
-                djdT_arr(i,j,k,g) = dZdT[g] / sumdZdT;
-            }
-        });
-    }
-}
-
-
 void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
                                        const MultiFab& temp_new,
                                        const MultiFab& temp_star,
                                        MultiFab& kappa_p, MultiFab& kappa_r, MultiFab& jg,
                                        MultiFab& djdT, MultiFab& dkdT, MultiFab& dedT,
-                                       int level, int it, int ngrow)
+                                       int level, int it, int ngrow,
+                                       MultiFab* etaT, MultiFab* etaTz, MultiFab* eta1,
+                                       const MultiFab* Er, Real delta_t, Real ptc_tau)
 {
+  BL_PROFILE("Radiation::eos_opacity_emissivity()");
+
   int star_is_valid = 1 - ngrow;
 
   int lag_opac;
@@ -262,50 +215,25 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
     lag_opac = 1;
   }
 
-  const Geometry& geom = parent->Geom(level);
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-  for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-      const Box& box = mfi.tilebox();
-
-      auto dedT_arr = dedT[mfi].array();
-      auto temp_arr = temp_new[mfi].array();
-      auto S_new_arr = S_new[mfi].array();
-
-      amrex::ParallelFor(box,
-      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-      {
-          Real rhoInv = 1.e0_rt / S_new_arr(i,j,k,URHO);
-
-          eos_re_t eos_state;
-          eos_state.rho = S_new_arr(i,j,k,URHO);
-          eos_state.T   = temp_arr(i,j,k);
-          for (int n = 0; n < NumSpec; ++n) {
-              eos_state.xn[n] = S_new_arr(i,j,k,UFS+n) * rhoInv;
-          }
-#if NAUX_NET > 0
-          for (int n = 0; n < NumAux; ++n) {
-              eos_state.aux[n] = S_new_arr(i,j,k,UFX+n) * rhoInv;
-          }
-#endif
-
-          eos(eos_input_rt, eos_state);
+  const bool do_etat = (etaT != nullptr);
+  AMREX_ALWAYS_ASSERT(!do_etat || (etaTz != nullptr && eta1 != nullptr && Er != nullptr));
 
-          dedT_arr(i,j,k) = eos_state.cv;
-      });
-  }
+  const Geometry& geom = parent->Geom(level);
 
-  if (dedT_fac > 1.0) {
-    dedT.mult(dedT_fac);
-  }
+  // Everything is done in a single pass over the zones: the EOS, the
+  // opacities of all groups and their temperature derivatives, the
+  // emissivities, and, if asked for, the coupling coefficients etaT.
+  // The per-group values of a zone are kept together in local arrays
+  // between these steps instead of being written out and read back
+  // by separate kernels.  The opacities are needed in the ghost cells
+  // (for kappa_r), the rest only in the valid region.
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
   for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
       const Box& bx = mfi.growntilebox(ngrow);
+      const Box& reg = mfi.tilebox();
 
       auto S_new_arr = S_new[mfi].array();
       auto temp_new_arr = temp_new[mfi].array();
@@ -315,8 +243,21 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
       auto dkdT_arr = dkdT[mfi].array();
       auto jg_arr = jg[mfi].array();
       auto djdT_arr = djdT[mfi].array();
+      auto dedT_arr = dedT[mfi].array();
+
+      Array4<Real> etaT_arr;
+      Array4<Real> etaTz_arr;
+      Array4<Real> eta1_arr;
+      Array4<Real const> Er_arr;
+      if (do_etat) {
+          etaT_arr = (*etaT)[mfi].array();
+          etaTz_arr = (*etaTz)[mfi].array();
+          eta1_arr = (*eta1)[mfi].array();
+          Er_arr = (*Er)[mfi].const_array();
+      }
 
       bool use_dkdT_loc = use_dkdT;
+      Real dedT_fac_loc = dedT_fac;
 
       GpuArray<Real, NGROUPS> nugroup_loc;
       for (int g = 0; g < NGROUPS; ++g) {
@@ -327,79 +268,130 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
           xnu_loc[g] = xnu[g];
       }
 
+      const bool use_bb_table = radiation::use_blackbody_table;
+      const auto bb_tab = bb_table.view();
+
       amrex::ParallelFor(bx,
       [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
       {
           const Real fac = 0.5e0_rt;
           const Real minfrac = 1.e-8_rt;
 
-          if (lag_opac) {
-              dkdT_arr(i,j,k) = 0.0_rt;
-              return;
-          }
+          const bool valid = reg.contains(i,j,k);
 
           Real rho = S_new_arr(i,j,k,URHO);
           Real temp = temp_new_arr(i,j,k);
 
-          Real Ye;
-          if (NumAux > 0) {
-              Real Ye = S_new_arr(i,j,k,UFX);
-          } else {
-              Ye = 0.e0_rt;
-          }
+          Real cv = 0.0_rt;
 
-          Real dT;
-          if (star_is_valid > 0) {
-              dT = fac * std::abs(temp_star_arr(i,j,k) - temp_new_arr(i,j,k));
-              dT = amrex::max(dT, minfrac * temp_new_arr(i,j,k));
-          } else {
-              dT = temp_new_arr(i,j,k) * 1.e-3_rt + 1.e-50_rt;
+          if (valid) {
+              Real rhoInv = 1.e0_rt / rho;
+
+              eos_re_t eos_state;
+              eos_state.rho = rho;
+              eos_state.T   = temp;
+              for (int n = 0; n < NumSpec; ++n) {
+                  eos_state.xn[n] = S_new_arr(i,j,k,UFS+n) * rhoInv;
+              }
+#if NAUX_NET > 0
+              for (int n = 0; n < NumAux; ++n) {
+                  eos_state.aux[n] = S_new_arr(i,j,k,UFX+n) * rhoInv;
+              }
+#endif
+
+              eos(eos_input_rt, eos_state);
+
+              cv = eos_state.cv;
+              if (dedT_fac_loc > 1.0_rt) {
+                  cv *= dedT_fac_loc;
+              }
+              dedT_arr(i,j,k) = cv;
           }
 
-          for (int g = 0; g < NGROUPS; ++g) {
-              Real nu = nugroup_loc[g];
+          Real kp[NGROUPS];
+          Real dk[NGROUPS];
 
-              bool comp_kp = true;
-              bool comp_kr = true;
+          if (lag_opac) {
 
-              Real kp, kr;
+              dkdT_arr(i,j,k) = 0.0_rt;
 
-              opacity(kp, kr, rho, temp, Ye, nu, comp_kp, comp_kr);
+              if (!valid) {
+                  return;
+              }
 
-              kappa_p_arr(i,j,k,g) = kp;
-              kappa_r_arr(i,j,k,g) = kr;
+              for (int g = 0; g < NGROUPS; ++g) {
+                  kp[g] = kappa_p_arr(i,j,k,g);
+                  dk[g] = dkdT_arr(i,j,k,g);
+              }
 
-              if (use_dkdT_loc == 0) {
+          } else {
 
-                  dkdT_arr(i,j,k,g) = 0.e0_rt;
+              Real Ye;
+              if (NumAux > 0) {
+                  Real Ye = S_new_arr(i,j,k,UFX);
+              } else {
+                  Ye = 0.e0_rt;
+              }
 
+              Real dT;
+              if (star_is_valid > 0) {
+                  dT = fac * std::abs(temp_star_arr(i,j,k) - temp_new_arr(i,j,k));
+                  dT = amrex::max(dT, minfrac * temp_new_arr(i,j,k));
               } else {
+                  dT = temp_new_arr(i,j,k) * 1.e-3_rt + 1.e-50_rt;
+              }
+
+              for (int g = 0; g < NGROUPS; ++g) {
+                  Real nu = nugroup_loc[g];
 
                   bool comp_kp = true;
-                  bool comp_kr = false;
+                  bool comp_kr = true;
+
+                  Real kr;
 
-                  Real kp1, kr1, kp2, kr2;
+                  opacity(kp[g], kr, rho, temp, Ye, nu, comp_kp, comp_kr);
 
-                  opacity(kp1, kr1, rho, temp-dT, Ye, nu, comp_kp, comp_kr);
-                  opacity(kp2, kr2, rho, temp+dT, Ye, nu, comp_kp, comp_kr);
+                  kappa_p_arr(i,j,k,g) = kp[g];
+                  kappa_r_arr(i,j,k,g) = kr;
 
-                  dkdT_arr(i,j,k,g) = (kp2 - kp1) / (2.e0_rt * dT);
+                  if (use_dkdT_loc == 0) {
+
+                      dk[g] = 0.e0_rt;
+
+                  } else {
+
+                      comp_kp = true;
+                      comp_kr = false;
+
+                      Real kp1, kr1, kp2, kr2;
+
+                      opacity(kp1, kr1, rho, temp-dT, Ye, nu, comp_kp, comp_kr);
+                      opacity(kp2, kr2, rho, temp+dT, Ye, nu, comp_kp, comp_kr);
+
+                      dk[g] = (kp2 - kp1) / (2.e0_rt * dT);
+                  }
+
+                  dkdT_arr(i,j,k,g) = dk[g];
               }
-          }
-      });
 
-      const Box& reg = mfi.tilebox();
+              if (!valid) {
+                  return;
+              }
+          }
 
-      amrex::ParallelFor(reg,
-      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-      {
           // Integrate the Planck distribution upward from zero frequency.
           // This handles both the single-group and multi-group cases.
 
-          Real Teff = amrex::max(temp_new_arr(i,j,k), 1.e-50_rt);
+          Real Teff = amrex::max(temp, 1.e-50_rt);
+
+          Real dj[NGROUPS];
 
           Real B1, dBdT1;
-          BdBdTIndefInteg(Teff, 0.0_rt, B1, dBdT1);
+          if (use_bb_table) {
+              BdBdTIndefIntegTable(bb_tab, Teff, 0.0_rt, B1, dBdT1);
+          } else {
+              BdBdTIndefInteg(Teff, 0.0_rt, B1, dBdT1);
+          }
 
           for (int g = 0; g < NGROUPS; ++g) {
 
@@ -414,19 +406,56 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
 
               Real B0 = B1;
               Real dBdT0 = dBdT1;
-              BdBdTIndefInteg(Teff, xnup, B1, dBdT1);
+              if (use_bb_table) {
+                  BdBdTIndefIntegTable(bb_tab, Teff, xnup, B1, dBdT1);
+              } else {
+                  BdBdTIndefInteg(Teff, xnup, B1, dBdT1);
+              }
               Real Bg = B1 - B0;
               Real dBdT = dBdT1 - dBdT0;
 
-              jg_arr(i,j,k,g) = Bg * kappa_p_arr(i,j,k,g);
-              djdT_arr(i,j,k,g) = dkdT_arr(i,j,k,g) * Bg + dBdT * kappa_p_arr(i,j,k,g);
+              Real j_g = Bg * kp[g];
+              dj[g] = dk[g] * Bg + dBdT * kp[g];
 
               // Allow a problem to override this emissivity.
 
               problem_emissivity(i, j, k, g,
                                  nugroup_loc, xnu_loc,
-                                 temp_new_arr(i,j,k), kappa_p_arr(i,j,k,g),
-                                 dkdT_arr(i,j,k,g), jg_arr(i,j,k,g), djdT_arr(i,j,k,g));
+                                 temp, kp[g], dk[g], j_g, dj[g]);
+
+              jg_arr(i,j,k,g) = j_g;
+          }
+
+          if (!do_etat) {
+              for (int g = 0; g < NGROUPS; ++g) {
+                  djdT_arr(i,j,k,g) = dj[g];
+              }
+              return;
+          }
+
+          // The coupling coefficients of the linearized matter update;
+          // djdT is replaced by mugT.
+
+          Real sigma = 1.e0_rt + ptc_tau;
+          Real cdt = C::c_light * delta_t;
+
+          Real sumdZdT = 0.0_rt;
+          for (int g = 0; g < NGROUPS; ++g) {
+              dj[g] -= dk[g] * Er_arr(i,j,k,g);
+              sumdZdT += dj[g];
+          }
+
+          if (sumdZdT == 0.0_rt) {
+              sumdZdT = 1.e-50_rt;
+          }
+
+          Real foo = cdt * sumdZdT;
+          Real bar = sigma * rho * cv;
+          etaT_arr(i,j,k) = foo / (foo + bar);
+          etaTz_arr(i,j,k) = etaT_arr(i,j,k) / sumdZdT;
+          eta1_arr(i,j,k) = bar / (foo + bar);
+          for (int g = 0; g < NGROUPS; ++g) {
+              djdT_arr(i,j,k,g) = dj[g] / sumdZdT;
           }
       });
   }
@@ -203,7 +203,9 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
                              temp_star, // input
                              kappa_p, kappa_r, jg,
                              djdT, dkdT, dedT, // output
-                             level, it, 1);
+                             level, it, 1,
+                             &etaT, &etaTz, &eta1, &Er_new,
+                             delta_t, ptc_tau);
       // It's OK that temp_star does not have a valid value for it==1
     }
 
@@ -222,14 +224,8 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
       }
     }
 
-    // djdT is both input and output
-    compute_etat(etaT, etaTz,
-                 eta1, djdT,
-                 dkdT, dedT,
-                 Er_star, rho,
-                 delta_t, ptc_tau);
-
-    // After this, djdT contains mugT.
+    // etaT, etaTz and eta1 were computed along with the opacities,
+    // about Er_new, which is Er_star now, and djdT contains mugT.
 
     // The inner loops does not update rhoe and T
     int innerIteration = 0;
@@ -256,6 +252,33 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
       compute_coupling(coupT, kappa_p, Er_pi, jg);
 
+      if (radsolve::block_solve) {
+
+        // all groups at once, with the coupling term of levelRhs
+        // (c H_g coupT) moved to the matrix, leaving -c H_g sum_g j_g
+
+        MultiFab coupJ(grids, dmap, 1, 0);
+        coupJ.setVal(0.0);
+        for (int igroup=0; igroup<nGroups; ++igroup) {
+          MultiFab::Subtract(coupJ, jg, igroup, 0, 1, 0);
+        }
+
+        MultiFab rhs(grids, dmap, nGroups, 0);
+        for (int igroup=0; igroup<nGroups; ++igroup) {
+          set_current_group(igroup);
+          MultiFab rhs_g(rhs, amrex::make_alias, igroup, 1);
+          solver->levelRhs(level, rhs_g, jg, mugT,
+                           coupJ, etaT,
+                           Er_step, rhoe_step, Er_star, rhoe_star,
+                           delta_t, igroup, it, ptc_tau);
+        }
+
+        solver->levelBlockSolve(level, Er_new, rhs, mgbd, lambda,
+                                kappa_p, kappa_r, mugT, etaT,
+                                delta_t, c, ptc_tau,
+                                have_Sanchez_Pomraning, lo_bc, hi_bc);
+      }
+
       for (int igroup=0; igroup<nGroups; ++igroup) {
 
         set_current_group(igroup);
@@ -265,7 +288,9 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
         // set boundary condition
         solver->levelBndry(mgbd, igroup);
 
-        solver->levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
+        if (!radsolve::block_solve) {
+          solver->levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
+        }
 
         int lamcomp = (radiation::limiter==0) ? 0 : igroup;
         solver->levelBCoeffs(level, lambda, kappa_r, igroup, c, lamcomp);
@@ -274,7 +299,7 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
           solver->levelSPas(level, lambda, igroup, lo_bc, hi_bc);
         }
 
-        { // src and rhd block
+        if (!radsolve::block_solve) { // src and rhd block
 
           MultiFab rhs(grids,dmap,1,0);
 
@@ -332,7 +357,8 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
         relative_in_prev = relative_in;
         absolute_in_prev = absolute_in;
 
-        if (accel_allowed) {
+        // the block solve has no lagged coupling to accelerate
+        if (accel_allowed && !radsolve::block_solve) {
           if (accelerate == 1) {
             local_accel(Er_new, Er_pi, kappa_p, etaT,
                         mugT, delta_t, ptc_tau);
@@ -403,7 +429,9 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
                            temp_star, // input
                            kappa_p, kappa_r, jg,
                            djdT, dkdT, dedT, // output
-                           level, it+1, 0);
+                           level, it+1, 0,
+                           &etaT, &etaTz, &eta1, &Er_new,
+                           delta_t, ptc_tau);
 
     check_convergence_matt(rhoe_new, rhoe_star, rhoe_step, Er_new,
                            temp_new, temp_star,
@@ -473,7 +501,9 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
                              temp_star, // input
                              kappa_p, kappa_r, jg,
                              djdT, dkdT, dedT, // output
-                             level, it+1, 0);
+                             level, it+1, 0,
+                             &etaT, &etaTz, &eta1, &Er_new,
+                             delta_t, ptc_tau);
     }
 
   } while ( ((!converged || !inner_converged) && it<maxiter)
@@ -492,6 +522,10 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
     std::cout.precision(oldprec);
   }
 
+  if (radsolve::verbose >= 1) {
+      solver->printSolveTimes(level);
+  }
+
   if (!converged) {
       amrex::Abort("Implicit Update Failed to Converge");
   }
@@ -0,0 +1,609 @@
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_LO_BCTYPES.H>
+
+#include <MLMGABec.H>
+#include <HABEC.H>
+#include <rad_util.H>
+
+#include <iostream>
+
+using namespace amrex;
+
+Real MLMGABec::flux_factor = 1.0;
+
+MLMGABec::MLMGABec(const BoxArray& grids,
+                   const DistributionMapping& dmap,
+                   const Geometry& _geom,
+                   int _crse_ratio, int _ncomp)
+  : geom(_geom), ncomp(_ncomp), crse_ratio(_crse_ratio)
+{
+  ParmParse pp("mlabec");
+
+  verbose = 0; pp.query("v", verbose); pp.query("verbose", verbose);
+  bottom_verbose = 0; pp.query("bottom_verbose", bottom_verbose);
+  max_fmg_iter = 0; pp.query("max_fmg_iter", max_fmg_iter);
+  block_vcycles = 2; pp.query("block_vcycles", block_vcycles);
+
+  static int first = 1;
+  if (verbose >= 1 && first && ParallelDescriptor::IOProcessor()) {
+    first = 0;
+    std::cout << "mlabec.verbose                  = " << verbose << std::endl;
+    std::cout << "mlabec.bottom_verbose           = " << bottom_verbose << std::endl;
+    std::cout << "mlabec.max_fmg_iter             = " << max_fmg_iter << std::endl;
+    std::cout << "mlabec.block_vcycles            = " << block_vcycles << std::endl;
+  }
+
+  acoefs.define(grids, dmap, ncomp, 0);
+  acoefs.setVal(0.0);
+  acoefs_eff.define(grids, dmap, ncomp, 0);
+
+  for (int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+    BoxArray edge_boxes(grids);
+    edge_boxes.surroundingNodes(idim);
+    bcoefs[idim].define(edge_boxes, dmap, ncomp, 0);
+    bcoefs[idim].setVal(0.0);
+    bcoefs_eff[idim].define(edge_boxes, dmap, ncomp, 0);
+  }
+
+  // The coefficients already contain the metric terms, so MLMG is
+  // told to treat the geometry as Cartesian.
+
+  LPInfo info;
+  info.setMetricTerm(false);
+
+  // All of the physical boundary conditions are folded into the
+  // coefficients, so MLMG only sees homogeneous Neumann boundaries
+  // (apart from periodic ones).
+
+  Array<LinOpBCType, AMREX_SPACEDIM> lobc;
+  Array<LinOpBCType, AMREX_SPACEDIM> hibc;
+  for (int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+    if (geom.isPeriodic(idim)) {
+      lobc[idim] = LinOpBCType::Periodic;
+      hibc[idim] = LinOpBCType::Periodic;
+    }
+    else {
+      lobc[idim] = LinOpBCType::Neumann;
+      hibc[idim] = LinOpBCType::Neumann;
+    }
+  }
+
+  // The same holds for the boundaries with a coarser level.  MLMG
+  // still wants coarse data there, but with b = 0 on those faces its
+  // values do not matter.
+
+  mlabec.resize(ncomp);
+
+  for (int n = 0; n < ncomp; n++) {
+    mlabec[n] = std::make_unique<MLABecLaplacian>(Vector<Geometry>{geom},
+                                                  Vector<BoxArray>{grids},
+                                                  Vector<DistributionMapping>{dmap},
+                                                  info);
+
+    mlabec[n]->setDomainBC(lobc, hibc);
+
+    if (mlabec[n]->needsCoarseDataForBC()) {
+      if (!crse_bc) {
+        BoxArray crse_grids(grids);
+        crse_grids.coarsen(crse_ratio);
+        crse_bc = std::make_unique<MultiFab>(crse_grids, dmap, 1, 1);
+        crse_bc->setVal(0.0);
+      }
+      mlabec[n]->setCoarseFineBC(crse_bc.get(), crse_ratio);
+    }
+
+    mlabec[n]->setLevelBC(0, nullptr);
+  }
+}
+
+void MLMGABec::setScalars(Real Alpha, Real Beta)
+{
+  alpha = Alpha;
+  beta  = Beta;
+}
+
+void MLMGABec::aCoefficients(const MultiFab &a, int comp)
+{
+  BL_ASSERT( a.ok() );
+  BL_ASSERT( a.boxArray() == acoefs.boxArray() );
+  MultiFab::Copy(acoefs, a, 0, comp, 1, 0);
+}
+
+void MLMGABec::bCoefficients(const MultiFab &b, int dir, int comp)
+{
+  BL_ASSERT( b.ok() );
+  BL_ASSERT( b.boxArray() == bcoefs[dir].boxArray() );
+  MultiFab::Copy(bcoefs[dir], b, 0, comp, 1, 0);
+}
+
+void MLMGABec::SPalpha(const MultiFab& a, int comp)
+{
+  BL_ASSERT( a.ok() );
+  if (SPa == 0) {
+    const BoxArray& grids = a.boxArray();
+    const DistributionMapping& dmap = a.DistributionMap();
+    SPa.reset(new MultiFab(grids,dmap,ncomp,0));
+  }
+  MultiFab::Copy(*SPa, a, 0, comp, 1, 0);
+}
+
+void MLMGABec::setCoupling(const MultiFab& u, const MultiFab& v)
+{
+  BL_ASSERT( u.nComp() >= ncomp && v.nComp() >= ncomp );
+  if (!coup_u) {
+    coup_u = std::make_unique<MultiFab>(acoefs.boxArray(), acoefs.DistributionMap(), ncomp, 0);
+    coup_v = std::make_unique<MultiFab>(acoefs.boxArray(), acoefs.DistributionMap(), ncomp, 0);
+  }
+  MultiFab::Copy(*coup_u, u, 0, 0, ncomp, 0);
+  MultiFab::Copy(*coup_v, v, 0, 0, ncomp, 0);
+}
+
+void MLMGABec::boundaryFlux(MultiFab* Flux, MultiFab& Soln, int icomp,
+                            BC_Mode inhom)
+{
+    BL_PROFILE("MLMGABec::boundaryFlux");
+
+    const BoxArray &grids = Soln.boxArray();
+
+    const NGBndry& bd = getBndry();
+    const Box& domain = bd.getDomain();
+
+    const int bho = 0;
+    Real dx[AMREX_SPACEDIM];
+    for (int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+        dx[idim] = geom.CellSize(idim);
+    }
+
+    for (MFIter si(Soln); si.isValid(); ++si) {
+        int i = si.index();
+        const Box &reg = grids[i];
+        for (OrientationIter oitr; oitr; oitr++) {
+            int cdir(oitr());
+            int idim = oitr().coordDir();
+            const RadBoundCond &bct = bd.bndryConds(oitr())[i];
+            const Real      &bcl = bd.bndryLocs(oitr())[i];
+            const FArrayBox       &fs  = bd.bndryValues(oitr())[si];
+            const Mask      &msk = bd.bndryMasks(oitr(),i);
+
+            if (reg[oitr()] == domain[oitr()]) {
+                int bctype = bct;
+                Array4<int const> tf_arr;
+                if (bd.mixedBndry(oitr())) {
+                    const BaseFab<int> &tf = *(bd.bndryTypes(oitr())[i]);
+                    tf_arr = tf.array();
+                    bctype = -1;
+                }
+                Array4<Real const> sp_arr;
+                if (SPa != 0) {
+                    sp_arr = (*SPa)[si].array();
+                }
+                HABEC::hbflx3(Flux[idim][si].array(),
+                              Soln[si].array(icomp),
+                              reg,
+                              cdir, bctype,
+                              tf_arr,
+                              bho, bcl,
+                              fs.array(bdcomp),
+                              msk.array(),
+                              bcoefs[idim][si].array(),
+                              beta, dx, flux_factor,
+                              oitr(), geom.data(), inhom,
+                              sp_arr);
+            }
+            else {
+                HABEC::hbflx(Flux[idim][si].array(),
+                             Soln[si].array(icomp),
+                             reg,
+                             cdir, bct, bho, bcl,
+                             fs.array(bdcomp),
+                             msk.array(),
+                             bcoefs[idim][si].array(),
+                             beta, dx, inhom);
+            }
+        }
+    }
+}
+
+void MLMGABec::setupSolver(Real _reltol, Real _abstol, int _maxiter)
+{
+  reltol  = _reltol;
+  abstol  = _abstol;
+  maxiter = _maxiter;
+}
+
+void MLMGABec::applyBndry(MultiFab& rhs_eff, BC_Mode inhom)
+{
+  BL_PROFILE("MLMGABec::applyBndry");
+
+  // alpha is folded into a as well, and MLMG is given alpha = 1
+
+  MultiFab::Copy(acoefs_eff, acoefs, 0, 0, ncomp, 0);
+  acoefs_eff.mult(alpha);
+  for (int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+    MultiFab::Copy(bcoefs_eff[idim], bcoefs[idim], 0, 0, ncomp, 0);
+  }
+
+  const NGBndry& bd = getBndry();
+  const Box& domain = bd.getDomain();
+  const BoxArray& grids = acoefs.boxArray();
+  const GeometryData geomdata = geom.data();
+  const Real c = flux_factor;
+  const Real Beta = beta;
+  const int do_inhom = (inhom == Inhomogeneous_BC);
+
+  for (MFIter mfi(acoefs_eff); mfi.isValid(); ++mfi) {
+   for (int n = 0; n < ncomp; n++) {
+    const int igrid = mfi.index();
+    const Box& reg = grids[igrid];
+    const int reg_lo = reg.smallEnd(0);
+    const int reg_hi = reg.bigEnd(0);
+
+    Array4<Real> const a = acoefs_eff.array(mfi, n);
+    Array4<Real> const rhs = rhs_eff.array(mfi, n);
+
+    Array4<Real const> spa;
+    if (SPa != 0) {
+      spa = SPa->const_array(mfi, n);
+    }
+
+    for (OrientationIter oitr; oitr; oitr++) {
+      const Orientation ori = oitr();
+      const int idim = ori.coordDir();
+      const int ori_lo = ori.isLow() ? 1 : 0;
+      const Real h = geom.CellSize(idim);
+
+      const Real bcl = bd.bndryLocs(ori)[igrid];
+      Array4<int const> const mask = bd.bndryMasks(ori, igrid).const_array();
+      Array4<Real const> const bcval = bd.bndryValues(ori)[mfi].const_array(bdcomp + n);
+      Array4<Real> const b = bcoefs_eff[idim].array(mfi, n);
+
+      const bool on_domain = (reg[ori] == domain[ori]);
+
+      int bctype = bd.bndryConds(ori)[igrid];
+      Array4<int const> tf;
+      if (on_domain && bd.mixedBndry(ori)) {
+        tf = bd.bndryTypes(ori)[igrid]->const_array();
+        bctype = -1;
+      }
+
+      // the zones just inside the face, the offset to the zone just
+      // outside, and the offset to the face
+
+      Box bx(reg);
+      if (ori.isLow()) {
+        bx.setBig(idim, reg.smallEnd(idim));
+      }
+      else {
+        bx.setSmall(idim, reg.bigEnd(idim));
+      }
+
+      const IntVect iv_out = ori.isLow() ? -IntVect::TheDimensionVector(idim)
+                                         :  IntVect::TheDimensionVector(idim);
+      const IntVect iv_face = ori.isLow() ? IntVect::TheZeroVector()
+                                          : IntVect::TheDimensionVector(idim);
+      const Dim3 out = iv_out.dim3();
+      const Dim3 fo = iv_face.dim3();
+
+      amrex::ParallelFor(bx,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+      {
+          const int io = i + out.x;
+          const int jo = j + out.y;
+          const int ko = k + out.z;
+
+          if (mask(io,jo,ko) <= 0) {
+              // covered by another grid of this level
+              return;
+          }
+
+          const int iface = i + fo.x;
+          const int jface = j + fo.y;
+          const int kface = k + fo.z;
+
+          const Real bface = b(iface,jface,kface);
+
+          // the diagonal and the right hand side terms from the
+          // boundary, as in HypreABec::hbmat3/hbvec3 on the domain
+          // boundary and hbmat/hbvec at coarse-fine boundaries
+
+          Real bfm = 0.0_rt;
+          Real bfv = 0.0_rt;
+
+          const int bct = (bctype == -1) ? tf(io,jo,ko) : bctype;
+
+          if (on_domain) {
+              Real r;
+              face_metric(i, j, k, reg_lo, reg_hi, geomdata, idim, ori_lo, r);
+
+              if (bct == AMREX_LO_DIRICHLET) {
+                  bfv = (Beta / h) / (0.5_rt * h + bcl) * bface;
+                  bfm = bfv;
+              }
+              else if (bct == AMREX_LO_NEUMANN) {
+                  bfv = Beta * r / h;
+              }
+              else if (bct == AMREX_LO_MARSHAK) {
+                  bfv = 2.0_rt * Beta * r / h;
+                  bfm = 0.25_rt * c * bfv;
+              }
+              else if (bct == AMREX_LO_SANCHEZ_POMRANING) {
+                  bfv = 2.0_rt * Beta * r / h;
+                  bfm = spa(i,j,k) * c * bfv;
+              }
+          }
+          else {
+              if (bct == AMREX_LO_DIRICHLET) {
+                  bfv = (Beta / h) / (0.5_rt * h + bcl) * bface;
+                  bfm = bfv;
+              }
+              else if (bct == AMREX_LO_NEUMANN) {
+                  bfv = (Beta / h) * bface;
+              }
+          }
+
+          a(i,j,k) += bfm;
+          if (do_inhom) {
+              rhs(i,j,k) += bfv * bcval(io,jo,ko);
+          }
+
+          // the face flux is now entirely in a and rhs
+          b(iface,jface,kface) = 0.0_rt;
+      });
+    }
+   }
+  }
+}
+
+void MLMGABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
+{
+  BL_PROFILE("MLMGABec::solve");
+
+  const BoxArray& grids = acoefs.boxArray();
+  const DistributionMapping& dmap = acoefs.DistributionMap();
+
+  MultiFab rhs_eff(grids, dmap, ncomp, 0);
+  MultiFab::Copy(rhs_eff, rhs, 0, 0, ncomp, 0);
+
+  applyBndry(rhs_eff, inhom);
+
+  Vector<std::unique_ptr<MLMG>> mlmg(ncomp);
+
+  for (int n = 0; n < ncomp; n++) {
+    mlabec[n]->setScalars(1.0, beta);
+    mlabec[n]->setACoeffs(0, MultiFab(acoefs_eff, amrex::make_alias, n, 1));
+
+    Array<MultiFab, AMREX_SPACEDIM> b_n;
+    for (int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+      b_n[idim] = MultiFab(bcoefs_eff[idim], amrex::make_alias, n, 1);
+    }
+    mlabec[n]->setBCoeffs(0, GetArrOfConstPtrs(b_n));
+
+    mlmg[n] = std::make_unique<MLMG>(*mlabec[n]);
+    mlmg[n]->setMaxFmgIter(max_fmg_iter);
+    mlmg[n]->setBottomVerbose(bottom_verbose);
+  }
+
+  // use the current solution as the initial guess
+
+  MultiFab soln(grids, dmap, ncomp, 1);
+  soln.setVal(0.0);
+  MultiFab::Copy(soln, dest, icomp, 0, ncomp, 0);
+
+  if (coup_u) {
+    blockSolve(mlmg, soln, rhs_eff);
+  }
+  else {
+    final_resnorm = 0.0;
+
+    for (int n = 0; n < ncomp; n++) {
+      MultiFab soln_n(soln, amrex::make_alias, n, 1);
+      MultiFab rhs_n(rhs_eff, amrex::make_alias, n, 1);
+
+      mlmg[n]->setMaxIter(maxiter);
+      mlmg[n]->setVerbose(verbose);
+      mlmg[n]->solve({&soln_n}, {&rhs_n}, reltol, abstol);
+
+      final_resnorm = amrex::max(final_resnorm, mlmg[n]->getFinalResidual());
+    }
+  }
+
+  MultiFab::Copy(dest, soln, 0, icomp, ncomp, 0);
+}
+
+void MLMGABec::blockApply(Vector<std::unique_ptr<MLMG>>& mlmg,
+                          MultiFab& out, MultiFab& in)
+{
+  BL_PROFILE("MLMGABec::blockApply");
+
+  for (int n = 0; n < ncomp; n++) {
+    MultiFab out_n(out, amrex::make_alias, n, 1);
+    MultiFab in_n(in, amrex::make_alias, n, 1);
+    mlmg[n]->apply({&out_n}, {&in_n});
+  }
+
+  const int nc = ncomp;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  for (MFIter mfi(out, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    const Box& bx = mfi.tilebox();
+
+    auto o = out.array(mfi);
+    auto x = in.const_array(mfi);
+    auto u = coup_u->const_array(mfi);
+    auto v = coup_v->const_array(mfi);
+
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        Real vx = 0.0_rt;
+        for (int h = 0; h < nc; h++) {
+            vx += v(i,j,k,h) * x(i,j,k,h);
+        }
+        for (int g = 0; g < nc; g++) {
+            o(i,j,k,g) -= u(i,j,k,g) * vx;
+        }
+    });
+  }
+}
+
+void MLMGABec::blockPrecond(Vector<std::unique_ptr<MLMG>>& mlmg,
+                            MultiFab& z, const MultiFab& r)
+{
+  BL_PROFILE("MLMGABec::blockPrecond");
+
+  // a few V-cycles for each group on its own
+
+  z.setVal(0.0);
+
+  for (int n = 0; n < ncomp; n++) {
+    MultiFab z_n(z, amrex::make_alias, n, 1);
+    MultiFab r_n(r, amrex::make_alias, n, 1);
+    mlmg[n]->solve({&z_n}, {&r_n}, 0.0, 0.0);
+  }
+
+  // Then the coupling, with the operator for each group replaced by
+  // its diagonal part D = a: since the coupling in a zone is of rank
+  // one, (D - u v^T)^{-1} D z = z + D^{-1} u (v^T z) / (1 - v^T D^{-1} u).
+  // This is the same correction as Radiation::local_accel.
+
+  const int nc = ncomp;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  for (MFIter mfi(z, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    const Box& bx = mfi.tilebox();
+
+    auto zz = z.array(mfi);
+    auto a = acoefs_eff.const_array(mfi);
+    auto u = coup_u->const_array(mfi);
+    auto v = coup_v->const_array(mfi);
+
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        Real vz = 0.0_rt;
+        Real p = 1.0_rt;
+        for (int h = 0; h < nc; h++) {
+            vz += v(i,j,k,h) * zz(i,j,k,h);
+            p -= v(i,j,k,h) * u(i,j,k,h) / a(i,j,k,h);
+        }
+        for (int g = 0; g < nc; g++) {
+            zz(i,j,k,g) += u(i,j,k,g) / a(i,j,k,g) * vz / (p + 1.e-50_rt);
+        }
+    });
+  }
+}
+
+void MLMGABec::blockSolve(Vector<std::unique_ptr<MLMG>>& mlmg,
+                          MultiFab& x, const MultiFab& f)
+{
+  BL_PROFILE("MLMGABec::blockSolve");
+
+  const BoxArray& grids = acoefs.boxArray();
+  const DistributionMapping& dmap = acoefs.DistributionMap();
+
+  for (int n = 0; n < ncomp; n++) {
+    mlmg[n]->setFixedIter(block_vcycles);
+    mlmg[n]->setVerbose(0);
+  }
+
+  auto norm = [&] (const MultiFab& mf) -> Real
+  {
+    Real nrm = 0.0;
+    for (int n = 0; n < ncomp; n++) {
+      nrm = amrex::max(nrm, mf.norm0(n, 0, true));
+    }
+    ParallelDescriptor::ReduceRealMax(nrm);
+    return nrm;
+  };
+
+  // right preconditioned BiCGStab
+
+  MultiFab r(grids, dmap, ncomp, 0);
+  MultiFab rh(grids, dmap, ncomp, 0);
+  MultiFab p(grids, dmap, ncomp, 0);
+  MultiFab v(grids, dmap, ncomp, 1);
+  MultiFab s(grids, dmap, ncomp, 0);
+  MultiFab t(grids, dmap, ncomp, 1);
+  MultiFab ph(grids, dmap, ncomp, 1);
+  MultiFab sh(grids, dmap, ncomp, 1);
+
+  blockApply(mlmg, r, x);
+  MultiFab::Xpay(r, -1.0, f, 0, 0, ncomp, 0);
+  MultiFab::Copy(rh, r, 0, 0, ncomp, 0);
+  p.setVal(0.0);
+  v.setVal(0.0);
+
+  const Real rnorm0 = norm(r);
+  const Real target = amrex::max(abstol, reltol * rnorm0);
+
+  Real rnorm = rnorm0;
+  Real rho = 1.0, alpha = 1.0, omega = 1.0;
+
+  int iter = 0;
+  bool converged = (rnorm <= target);
+
+  while (!converged && iter < maxiter) {
+    iter++;
+
+    const Real rho_new = MultiFab::Dot(rh, 0, r, 0, ncomp, 0);
+    if (rho_new == 0.0) {
+      break;
+    }
+
+    if (iter == 1) {
+      MultiFab::Copy(p, r, 0, 0, ncomp, 0);
+    }
+    else {
+      const Real bet = (rho_new / rho) * (alpha / omega);
+      MultiFab::Saxpy(p, -omega, v, 0, 0, ncomp, 0);
+      MultiFab::Xpay(p, bet, r, 0, 0, ncomp, 0);
+    }
+    rho = rho_new;
+
+    blockPrecond(mlmg, ph, p);
+    blockApply(mlmg, v, ph);
+
+    alpha = rho / MultiFab::Dot(rh, 0, v, 0, ncomp, 0);
+
+    MultiFab::LinComb(s, 1.0, r, 0, -alpha, v, 0, 0, ncomp, 0);
+
+    rnorm = norm(s);
+    if (rnorm <= target) {
+      MultiFab::Saxpy(x, alpha, ph, 0, 0, ncomp, 0);
+      converged = true;
+      break;
+    }
+
+    blockPrecond(mlmg, sh, s);
+    blockApply(mlmg, t, sh);
+
+    const Real tt = MultiFab::Dot(t, 0, t, 0, ncomp, 0);
+    omega = (tt > 0.0) ? MultiFab::Dot(t, 0, s, 0, ncomp, 0) / tt : 0.0;
+
+    MultiFab::Saxpy(x, alpha, ph, 0, 0, ncomp, 0);
+    MultiFab::Saxpy(x, omega, sh, 0, 0, ncomp, 0);
+
+    MultiFab::LinComb(r, 1.0, s, 0, -omega, t, 0, 0, ncomp, 0);
+
+    rnorm = norm(r);
+    converged = (rnorm <= target);
+
+    if (omega == 0.0) {
+      break;
+    }
+  }
+
+  final_resnorm = rnorm;
+
+  if (verbose >= 1) {
+    amrex::Print() << "MLMGABec: coupled solve of " << ncomp << " groups, "
+                   << iter << " BiCGStab iterations, residual "
+                   << rnorm0 << " -> " << rnorm
+                   << (converged ? "" : " (not converged)") << std::endl;
+  }
+}
@@ -8,6 +8,7 @@
 #include <rad_util.H>
 #include <problem_rad_source.H>
 
+#include <iomanip>
 #include <iostream>
 
 #ifdef _OPENMP
@@ -21,7 +22,12 @@ RadSolve::RadSolve (Amr* Parent, int level, const BoxArray& grids, const Distrib
 {
     read_params();
 
-    if (radsolve::level_solver_flag < 100) {
+    if (radsolve::use_mlmg) {
+        const int crse_ratio = (level > 0) ? parent->refRatio(level-1)[0] : 2;
+        ml.reset(new MLMGABec(grids, dmap, parent->Geom(level), crse_ratio));
+    }
+#ifdef AMREX_USE_HYPRE
+    else if (radsolve::level_solver_flag < 100) {
         hd.reset(new HypreABec(grids, dmap, parent->Geom(level), radsolve::level_solver_flag));
     }
     else {
@@ -41,6 +47,12 @@ RadSolve::RadSolve (Amr* Parent, int level, const BoxArray& grids, const Distrib
             hem->buildMatrixStructure();
         }
     }
+#endif
+
+    if (radsolve::block_solve && Radiation::SolverType == Radiation::MGFLDSolver) {
+        const int crse_ratio = (level > 0) ? parent->refRatio(level-1)[0] : 2;
+        mlb.reset(new MLMGABec(grids, dmap, parent->Geom(level), crse_ratio, Radiation::nGroups));
+    }
 }
 
 void
@@ -55,6 +67,11 @@ RadSolve::read_params ()
         radsolve::abstol = 0.0;
     }
 
+#ifndef AMREX_USE_HYPRE
+    // without Hypre the MLMG solver is the only choice
+    radsolve::use_mlmg = 1;
+#endif
+
     // Check for unsupported options.
 
     if (AMREX_SPACEDIM == 1) {
@@ -66,6 +83,10 @@ RadSolve::read_params ()
     if (Radiation::SolverType == Radiation::SGFLDSolver
         && Radiation::Er_Lorentz_term) {
 
+        if (radsolve::use_mlmg) {
+            amrex::Error("To do Lorentz term implicitly the Hypre solvers must be used (radsolve.use_mlmg = 0).");
+        }
+
         if (radsolve::level_solver_flag < 100) {
             amrex::Error("To do Lorentz term implicitly level_solver_flag must be >= 100.");
         }
@@ -78,6 +99,10 @@ RadSolve::read_params ()
     if (Radiation::SolverType == Radiation::MGFLDSolver &&
         Radiation::accelerate == 2 && Radiation::nGroups > 1) {
 
+        if (radsolve::use_mlmg) {
+            amrex::Error("When accelerate is 2, the Hypre solvers must be used (radsolve.use_mlmg = 0).");
+        }
+
         if (radsolve::level_solver_flag < 100) {
             amrex::Error("When accelerate is 2, level_solver_flag must be >= 100.");
         }
@@ -98,7 +123,11 @@ void RadSolve::levelBndry(RadBndry& bd)
 {
   BL_PROFILE("RadSolve::levelBndry");
 
-  if (hd) {
+  if (ml) {
+    ml->setBndry(bd);
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hd) {
     hd->setBndry(bd);
   }
   else if (hm) {
@@ -107,6 +136,7 @@ void RadSolve::levelBndry(RadBndry& bd)
   else if (hem) {
     hem->setBndry(hem->crseLevel(), bd);
   }
+#endif
 }
 
 // update multigroup version
@@ -114,7 +144,11 @@ void RadSolve::levelBndry(MGRadBndry& mgbd, const int comp)
 {
   BL_PROFILE("RadSolve::levelBndryMG (updated)");
 
-  if (hd) {
+  if (ml) {
+    ml->setBndry(mgbd, comp);
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hd) {
     hd->setBndry(mgbd, comp);
   }
   else if (hm) {
@@ -123,6 +157,7 @@ void RadSolve::levelBndry(MGRadBndry& mgbd, const int comp)
   else if (hem) {
     hem->setBndry(hem->crseLevel(), mgbd, comp);
   }
+#endif
 }
 
 void RadSolve::cellCenteredApplyMetrics(int level, MultiFab& cc)
@@ -154,7 +189,11 @@ void RadSolve::cellCenteredApplyMetrics(int level, MultiFab& cc)
 
 void RadSolve::setLevelACoeffs(int level, const MultiFab& acoefs)
 {
-    if (hd) {
+    if (ml) {
+        ml->aCoefficients(acoefs);
+    }
+#ifdef AMREX_USE_HYPRE
+    else if (hd) {
         hd->aCoefficients(acoefs);
     }
     else if (hm) {
@@ -163,11 +202,16 @@ void RadSolve::setLevelACoeffs(int level, const MultiFab& acoefs)
     else if (hem) {
         hem->aCoefficients(level, acoefs);
     }
+#endif
 }
 
 void RadSolve::setLevelBCoeffs(int level, const MultiFab& bcoefs, int dir)
 {
-    if (hd) {
+    if (ml) {
+        ml->bCoefficients(bcoefs, dir);
+    }
+#ifdef AMREX_USE_HYPRE
+    else if (hd) {
         hd->bCoefficients(bcoefs, dir);
     }
     else if (hm) {
@@ -176,13 +220,16 @@ void RadSolve::setLevelBCoeffs(int level, const MultiFab& bcoefs, int dir)
     else if (hem) {
         hem->bCoefficients(level, bcoefs, dir);
     }
+#endif
 }
 
 void RadSolve::setLevelCCoeffs(int level, const MultiFab& ccoefs, int dir)
 {
+#ifdef AMREX_USE_HYPRE
     if (hem) {
       hem->cCoefficients(level, ccoefs, dir);
     }
+#endif
 }
 
 void RadSolve::levelACoeffs(int level,
@@ -231,7 +278,11 @@ void RadSolve::levelACoeffs(int level,
       });
   }
 
-  if (hd) {
+  if (ml) {
+    ml->aCoefficients(acoefs);
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hd) {
     hd->aCoefficients(acoefs);
   }
   else if (hm) {
@@ -240,6 +291,7 @@ void RadSolve::levelACoeffs(int level,
   else if (hem) {
     hem->aCoefficients(level, acoefs);
   }
+#endif
 }
 
 void RadSolve::levelSPas(int level, Array<MultiFab, AMREX_SPACEDIM>& lambda, int igroup,
@@ -247,10 +299,36 @@ void RadSolve::levelSPas(int level, Array<MultiFab, AMREX_SPACEDIM>& lambda, int
 {
   const BoxArray& grids = parent->boxArray(level);
   const DistributionMapping& dmap = parent->DistributionMap(level);
+
+  MultiFab spa(grids, dmap, 1, 0);
+  computeSPas(level, spa, lambda, igroup, lo_bc, hi_bc);
+
+  if (ml) {
+    ml->SPalpha(spa);
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hm) {
+    hm->SPalpha(level, spa);
+  }
+  else if (hem) {
+    hem->SPalpha(level, spa);
+  }
+  else if (hd) {
+    hd->SPalpha(spa);
+  }
+#endif
+  else {
+    amrex::Abort("Should not be in RadSolve::levelSPas");
+  }
+}
+
+void RadSolve::computeSPas(int level, MultiFab& spa,
+                           Array<MultiFab, AMREX_SPACEDIM>& lambda, int igroup,
+                           int lo_bc[3], int hi_bc[3])
+{
   const Geometry& geom = parent->Geom(level);
   const Box& domainBox = geom.Domain();
 
-  MultiFab spa(grids, dmap, 1, 0);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -313,19 +391,6 @@ void RadSolve::levelSPas(int level, Array<MultiFab, AMREX_SPACEDIM>& lambda, int
           });
       }
   }
-
-  if (hm) {
-    hm->SPalpha(level, spa);
-  }
-  else if (hem) {
-    hem->SPalpha(level, spa);
-  }
-  else if (hd) {
-    hd->SPalpha(spa);
-  }
-  else {
-    amrex::Abort("Should not be in RadSolve::levelSPas");
-  }
 }
 
 void RadSolve::levelBCoeffs(int level,
@@ -398,7 +463,11 @@ void RadSolve::levelBCoeffs(int level,
         });
     }
 
-    if (hd) {
+    if (ml) {
+        ml->bCoefficients(bcoefs, idim);
+    }
+#ifdef AMREX_USE_HYPRE
+    else if (hd) {
         hd->bCoefficients(bcoefs, idim);
     }
     else if (hm) {
@@ -407,6 +476,7 @@ void RadSolve::levelBCoeffs(int level,
     else if (hem) {
       hem->bCoefficients(level, bcoefs, idim);
     }
+#endif
   } // -->> over dimension
 }
 
@@ -414,6 +484,9 @@ void RadSolve::levelDCoeffs(int level, Array<MultiFab, AMREX_SPACEDIM>& lambda,
                             MultiFab& vel, MultiFab& dcf)
 {
     BL_PROFILE("RadSolve::levelDCoeffs");
+#ifndef AMREX_USE_HYPRE
+    amrex::Abort("RadSolve::levelDCoeffs: the nonsymmetric terms require Hypre");
+#else
     const Castro *castro = dynamic_cast<Castro*>(&parent->getLevel(level));
     const DistributionMapping& dm = castro->DistributionMap();
     const Geometry& geom = parent->Geom(level);
@@ -499,6 +572,7 @@ void RadSolve::levelDCoeffs(int level, Array<MultiFab, AMREX_SPACEDIM>& lambda,
         hem->d2Coefficients(level, dcoefs, idim);
         hem->d2Multiplier() = 1.0;
     }
+#endif
 }
 
 void RadSolve::levelRhs(int level, MultiFab& rhs,
@@ -582,7 +656,11 @@ void RadSolve::levelSolve(int level,
   BL_PROFILE("RadSolve::levelSolve");
 
   // Set coeffs, build solver, solve
-  if (hd) {
+  if (ml) {
+    ml->setScalars(radsolve::alpha, radsolve::beta);
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hd) {
     hd->setScalars(radsolve::alpha, radsolve::beta);
   }
   else if (hm) {
@@ -591,9 +669,35 @@ void RadSolve::levelSolve(int level,
   else if (hem) {
     hem->setScalars(radsolve::alpha, radsolve::beta);
   }
+#endif
+
+  const Real strt = ParallelDescriptor::second();
+  Real setup_end;
+  bool did_setup = true;
 
-  if (hd) {
-    hd->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+  if (ml) {
+    ml->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    setup_end = ParallelDescriptor::second();
+    ml->solve(Er, igroup, rhs, Inhomogeneous_BC);
+    Real res = ml->getAbsoluteResidual();
+    if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
+      int oldprec = std::cout.precision(20);
+      std::cout << "Absolute residual = " << res << std::endl;
+      std::cout.precision(oldprec);
+    }
+    res *= sync_absres_factor;
+    ml->clearSolver();
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hd) {
+    if (radsolve::reuse_setup) {
+      did_setup = hd->updateSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter,
+                                   radsolve::reuse_setup_tol, igroup);
+    }
+    else {
+      hd->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    }
+    setup_end = ParallelDescriptor::second();
     hd->solve(Er, igroup, rhs, Inhomogeneous_BC);
     Real res = hd->getAbsoluteResidual();
     if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
@@ -602,7 +706,9 @@ void RadSolve::levelSolve(int level,
       std::cout.precision(oldprec);
     }
     res *= sync_absres_factor;
-    hd->clearSolver();
+    if (!radsolve::reuse_setup) {
+      hd->clearSolver();
+    }
   }
   else if (hm) {
     hm->loadMatrix();
@@ -610,6 +716,7 @@ void RadSolve::levelSolve(int level,
     hm->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
     hm->finalizeVectors();
     hm->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    setup_end = ParallelDescriptor::second();
     hm->solve();
     hm->getSolution(level, Er, igroup);
     Real res = hm->getAbsoluteResidual();
@@ -627,6 +734,7 @@ void RadSolve::levelSolve(int level,
     hem->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
     hem->finalizeVectors();
     hem->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    setup_end = ParallelDescriptor::second();
     hem->solve();
     hem->getSolution(level, Er, igroup);
     Real res = hem->getAbsoluteResidual();
@@ -638,6 +746,64 @@ void RadSolve::levelSolve(int level,
     res *= sync_absres_factor;
     hem->clearSolver();
   }
+#endif
+  else {
+    return;
+  }
+
+  const Real end = ParallelDescriptor::second();
+
+  const int g = amrex::max(igroup, 0);
+  if (g >= static_cast<int>(solve_times.size())) {
+    solve_times.resize(g + 1);
+  }
+
+  if (did_setup) {
+    solve_times[g].nsetup++;
+  }
+  solve_times[g].nsolve++;
+  solve_times[g].setup += setup_end - strt;
+  solve_times[g].solve += end - setup_end;
+}
+
+void RadSolve::printSolveTimes(int level)
+{
+  int ngroups = static_cast<int>(solve_times.size());
+  ParallelDescriptor::ReduceIntMax(ngroups);
+  solve_times.resize(ngroups);
+
+  if (ngroups == 0) {
+    return;
+  }
+
+  Vector<Real> times(2 * ngroups);
+  for (int g = 0; g < ngroups; ++g) {
+    times[2*g  ] = solve_times[g].setup;
+    times[2*g+1] = solve_times[g].solve;
+  }
+  ParallelDescriptor::ReduceRealMax(times.data(), 2 * ngroups,
+                                    ParallelDescriptor::IOProcessorNumber());
+
+  amrex::Print() << "RadSolve on level " << level << ": group, setups, solves, setup time, solve time"
+                 << std::endl;
+
+  Real setup_total = 0.0;
+  Real solve_total = 0.0;
+
+  for (int g = 0; g < ngroups; ++g) {
+    amrex::Print() << "  " << std::setw(4) << g
+                   << "  " << std::setw(6) << solve_times[g].nsetup
+                   << "  " << std::setw(6) << solve_times[g].nsolve
+                   << "  " << std::setw(12) << times[2*g]
+                   << "  " << std::setw(12) << times[2*g+1] << std::endl;
+    setup_total += times[2*g];
+    solve_total += times[2*g+1];
+  }
+
+  amrex::Print() << "  total setup time = " << setup_total
+                 << ", total solve time = " << solve_total << std::endl;
+
+  solve_times.clear();
 }
 
 void RadSolve::levelFluxFaceToCenter(int level, const Array<MultiFab, AMREX_SPACEDIM>& Flux,
@@ -706,7 +872,11 @@ void RadSolve::levelFlux(int level,
 
       const MultiFab *bp;
 
-      if (hd) {
+      if (ml) {
+          bp = &ml->bCoefficients(n);
+      }
+#ifdef AMREX_USE_HYPRE
+      else if (hd) {
           bp = &hd->bCoefficients(n);
       }
       else if (hm) {
@@ -715,6 +885,7 @@ void RadSolve::levelFlux(int level,
       else if (hem) {
           bp = &hem->bCoefficients(level, n);
       }
+#endif
 
       MultiFab &bcoef = *(MultiFab*)bp;
 
@@ -768,12 +939,17 @@ void RadSolve::levelFlux(int level,
   // by themselves, though, because the current implementation
   // trashes the boundary fluxes before fixing them.
 
-  if (hd) {
+  if (ml) {
+    ml->boundaryFlux(&Flux[0], Er, igroup, Inhomogeneous_BC);
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hd) {
     hd->boundaryFlux(&Flux[0], Er, igroup, Inhomogeneous_BC);
   }
   else if (hm) {
     hm->boundaryFlux(level, &Flux[0], Er, igroup, Inhomogeneous_BC);
   }
+#endif
 }
 
 void RadSolve::levelFluxReg(int level,
@@ -808,6 +984,9 @@ void RadSolve::levelFluxReg(int level,
 void RadSolve::levelDterm(int level, MultiFab& Dterm, MultiFab& Er, int igroup)
 {
   BL_PROFILE("RadSolve::levelDterm");
+#ifndef AMREX_USE_HYPRE
+  amrex::Abort("RadSolve::levelDterm: the nonsymmetric terms require Hypre");
+#else
   const BoxArray& grids = parent->boxArray(level);
   const DistributionMapping& dmap = parent->DistributionMap(level);
   const Geometry& geom = parent->Geom(level);
@@ -921,6 +1100,7 @@ void RadSolve::levelDterm(int level, MultiFab& Dterm, MultiFab& Er, int igroup)
 #endif
       });
   }
+#endif
 }
 
 // <MGFLD routines>
@@ -997,7 +1177,6 @@ void RadSolve::levelACoeffs(int level, MultiFab& kpp,
   BL_PROFILE("RadSolve::levelACoeffs (MGFLD)");
   const BoxArray& grids = parent->boxArray(level);
   const DistributionMapping& dmap = parent->DistributionMap(level);
-  const auto geomdata = parent->Geom(level).data();
 
   // allocate space for ABecLaplacian acoeffs, fill with values
 
@@ -1005,6 +1184,30 @@ void RadSolve::levelACoeffs(int level, MultiFab& kpp,
   int Nghost = 0;
   MultiFab acoefs(grids, dmap, Ncomp, Nghost);
 
+  computeACoeffs(level, acoefs, kpp, delta_t, c, igroup, ptc_tau);
+
+  // set a coefficients
+  if (ml) {
+    ml->aCoefficients(acoefs);
+  }
+#ifdef AMREX_USE_HYPRE
+  else if (hd) {
+    hd->aCoefficients(acoefs);
+  }
+  else if (hm) {
+    hm->aCoefficients(level,acoefs);
+  }
+  else if (hem) {
+    hem->aCoefficients(level,acoefs);
+  }
+#endif
+}
+
+void RadSolve::computeACoeffs(int level, MultiFab& acoefs, MultiFab& kpp,
+                              Real delta_t, Real c, int igroup, Real ptc_tau)
+{
+  const auto geomdata = parent->Geom(level).data();
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -1027,17 +1230,6 @@ void RadSolve::levelACoeffs(int level, MultiFab& kpp,
           acoefs_arr(i,j,k) = r * s * acoefs_arr(i,j,k);
       });
   }
-
-  // set a coefficients
-  if (hd) {
-    hd->aCoefficients(acoefs);
-  }
-  else if (hm) {
-    hm->aCoefficients(level,acoefs);
-  }
-  else if (hem) {
-    hem->aCoefficients(level,acoefs);
-  }
 }
 
 
@@ -1093,24 +1285,108 @@ void RadSolve::levelRhs(int level, MultiFab& rhs, const MultiFab& jg,
   }
 }
 
+void RadSolve::levelBlockSolve(int level, MultiFab& Er, MultiFab& rhs, MGRadBndry& mgbd,
+                               Array<MultiFab, AMREX_SPACEDIM>& lambda,
+                               MultiFab& kappa_p, MultiFab& kappa_r,
+                               const MultiFab& mugT, const MultiFab& etaT,
+                               Real delta_t, Real c, Real ptc_tau,
+                               bool have_Sanchez_Pomraning, int lo_bc[], int hi_bc[])
+{
+  BL_PROFILE("RadSolve::levelBlockSolve (MGFLD)");
+  AMREX_ALWAYS_ASSERT(mlb);
+
+  const BoxArray& grids = parent->boxArray(level);
+  const DistributionMapping& dmap = parent->DistributionMap(level);
+  const Geometry& geom = parent->Geom(level);
+  const auto geomdata = geom.data();
+  const int ngroups = Radiation::nGroups;
+
+  mlb->setBndry(mgbd, 0);
+
+  MultiFab acoefs(grids, dmap, 1, 0);
+  MultiFab spa(grids, dmap, 1, 0);
+  Array<MultiFab, AMREX_SPACEDIM> bcoefs;
+  for (int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+      bcoefs[idim].define(lambda[idim].boxArray(), lambda[idim].DistributionMap(), 1, 0);
+  }
+
+  for (int igroup = 0; igroup < ngroups; ++igroup) {
+      computeACoeffs(level, acoefs, kappa_p, delta_t, c, igroup, ptc_tau);
+      mlb->aCoefficients(acoefs, igroup);
+
+      int lamcomp = (radiation::limiter == 0) ? 0 : igroup;
+      for (int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+          computeBCoeffs(bcoefs[idim], idim, kappa_r, igroup, lambda[idim], lamcomp, c, geom);
+          mlb->bCoefficients(bcoefs[idim], idim, igroup);
+      }
+
+      if (have_Sanchez_Pomraning) {
+          computeSPas(level, spa, lambda, igroup, lo_bc, hi_bc);
+          mlb->SPalpha(spa, igroup);
+      }
+  }
+
+  // The groups are coupled through the matter energy: group g gets
+  // c H_g sum_h (kappa_h E_h - j_h) with H_g = mugT_g etaT (see
+  // levelRhs), which is lagged in the group by group solves.
+
+  MultiFab coup_u(grids, dmap, ngroups, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  for (MFIter mfi(coup_u, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+      const Box& bx = mfi.tilebox();
+
+      auto u = coup_u[mfi].array();
+      auto mugT_arr = mugT[mfi].array();
+      auto etaT_arr = etaT[mfi].array();
+
+      amrex::ParallelFor(bx, ngroups,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int g)
+      {
+          Real r, s;
+          cell_center_metric(i, j, k, geomdata, r, s);
+
+          u(i,j,k,g) = r * C::c_light * mugT_arr(i,j,k,g) * etaT_arr(i,j,k);
+      });
+  }
+
+  mlb->setCoupling(coup_u, kappa_p);
+
+  mlb->setScalars(radsolve::alpha, radsolve::beta);
+  mlb->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+  mlb->solve(Er, 0, rhs, Inhomogeneous_BC);
+
+  if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
+      int oldprec = std::cout.precision(20);
+      std::cout << "Absolute residual = " << mlb->getAbsoluteResidual() << std::endl;
+      std::cout.precision(oldprec);
+  }
+}
+
 // </ MGFLD routines>
 
 void RadSolve::setHypreMulti(Real cMul, Real d1Mul, Real d2Mul)
 {
+#ifdef AMREX_USE_HYPRE
   if (hem) {
     hem-> cMultiplier() =  cMul;
     hem->d1Multiplier() = d1Mul;
     hem->d2Multiplier() = d2Mul;
   }
+#endif
 }
 
 void RadSolve::restoreHypreMulti()
 {
+#ifdef AMREX_USE_HYPRE
   if (hem) {
     hem-> cMultiplier() =  cMulti;
     hem->d1Multiplier() = d1Multi;
     hem->d2Multiplier() = d2Multi;
   }
+#endif
 }
 
 void RadSolve::getEdgeMetric(int idim, const Geometry& geom, const Box& edgebox,
@@ -301,8 +301,11 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
     // every instance of Hypre must use the same factor (or
     // be responsible for changing it internally).
 
+#ifdef AMREX_USE_HYPRE
     HypreABec::fluxFactor() = c;
     HypreMultiABec::fluxFactor() = c;
+#endif
+    MLMGABec::fluxFactor() = c;
 
   }
 
@@ -465,6 +468,13 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
     nugroup.resize(1, 1.0);
   }
 
+  // The table is a function of x = h nu / kT only, so a single one
+  // serves every group boundary in xnu.
+
+  if (radiation::use_blackbody_table) {
+    bb_table.build(radiation::blackbody_table_tol, verbose);
+  }
+
   // current implementation of the Radiation boundary condition reads
   // incoming flux information in the RadBndry constructor.  we just
   // set the boundary condition type here:
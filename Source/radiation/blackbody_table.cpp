@@ -0,0 +1,181 @@
+#include <Radiation.H>
+#include <blackbody.H>
+#include <blackbody_table.H>
+
+#include <iostream>
+
+using namespace amrex;
+
+namespace {
+
+///
+/// Tabulate ln q(x) on a uniform grid in s = ln x over [slo, shi],
+/// doubling the number of points from 64 until the relative error of
+/// the interpolated q is below tol.  dlnq(x) is the exact d ln q / ds.
+/// Returns the error reached, with the values, slopes and number of
+/// intervals in f, df and nint.
+///
+template <typename Q, typename DLNQ>
+Real
+build_segment (Q q, DLNQ dlnq, Real slo, Real shi, Real tol,
+               Vector<Real>& f, Vector<Real>& df, int& nint)
+{
+    // ln q is smooth, so the error falls by about 16 with each
+    // doubling.
+
+    const int nmax = 1 << 16;
+
+    Real err = 0.0_rt;
+
+    for (nint = 64; nint <= nmax; nint *= 2) {
+
+        const Real dsl = (shi - slo) / static_cast<Real>(nint);
+
+        f.resize(nint + 1);
+        df.resize(nint + 1);
+
+        for (int i = 0; i <= nint; ++i) {
+            const Real x = std::exp(slo + static_cast<Real>(i) * dsl);
+            f[i] = std::log(q(x));
+            df[i] = dlnq(x);
+        }
+
+        // Fritsch-Carlson: ln q is monotonic and the exact slopes
+        // have the same sign as the secants, but the interpolant is
+        // only guaranteed to be monotonic if they are not too large
+        // relative to the secant of each interval.
+
+        for (int i = 0; i < nint; ++i) {
+            const Real delta = (f[i+1] - f[i]) / dsl;
+            if (delta == 0.0_rt) {
+                df[i] = 0.0_rt;
+                df[i+1] = 0.0_rt;
+                continue;
+            }
+            const Real a = df[i] / delta;
+            const Real b = df[i+1] / delta;
+            const Real r2 = a * a + b * b;
+            if (r2 > 9.0_rt) {
+                const Real tau = 3.0_rt / std::sqrt(r2);
+                df[i] = tau * a * delta;
+                df[i+1] = tau * b * delta;
+            }
+        }
+
+        BlackbodyTableSegment seg;
+        seg.f = f.data();
+        seg.df = df.data();
+        seg.n = nint;
+        seg.s0 = slo;
+        seg.ds = dsl;
+        seg.dsinv = 1.0_rt / dsl;
+
+        // check the relative error between the points
+
+        err = 0.0_rt;
+        for (int i = 0; i < nint; ++i) {
+            for (int k = 1; k <= 3; ++k) {
+                const Real s = slo + (static_cast<Real>(i) + 0.25_rt * static_cast<Real>(k)) * dsl;
+                const Real qx = q(std::exp(s));
+                err = amrex::max(err, std::abs(std::exp(seg(s)) - qx) / qx);
+            }
+        }
+
+        if (err <= tol) {
+            break;
+        }
+    }
+
+    return err;
+}
+
+}
+
+void
+BlackbodyTable::build (Real tol, int verbose)
+{
+    BL_PROFILE("BlackbodyTable::build()");
+
+    const Real slo = std::log(blackbody::xsmall);
+    const Real smagic = std::log(blackbody::xmagic);
+    const Real shi = std::log(blackbody::xlarge);
+
+    // Below xmagic, the integral itself (to the tolerance of the
+    // series in blackbody.H)
+
+    Vector<Real> g, dg;
+
+    const Real err_lo = build_segment(
+        [] (Real x) -> Real { return integsmall(x); },
+        [] (Real x) -> Real { return x * x * x * x / std::expm1(x) / integsmall(x); },
+        slo, smagic, tol, g, dg, n);
+
+    // Above it, the tail magic_const - integ, which is what the group
+    // integrals there are differences of.  At xmagic itself we take
+    // the tail from the small-x series, so that the two pieces meet
+    // and the table stays monotonic across the join (the series
+    // differ there by about 1e-10).
+
+    const Real xjoin = std::exp(smagic);
+
+    auto tail = [=] (Real x) -> Real
+    {
+        return (x <= xjoin) ? blackbody::magic_const - integsmall(x) : integtail(x);
+    };
+
+    Vector<Real> h, dh;
+
+    const Real err_hi = build_segment(
+        tail,
+        [=] (Real x) -> Real { return -x * x * x * x / std::expm1(x) / tail(x); },
+        smagic, shi, tol, h, dh, nh);
+
+    const Real err = amrex::max(err_lo, err_hi);
+
+    if (err > tol) {
+        amrex::Abort("BlackbodyTable: cannot reach radiation.blackbody_table_tol; it may be below the accuracy of the series themselves");
+    }
+
+    s0 = slo;
+    ds = (smagic - slo) / static_cast<Real>(n);
+
+    sh0 = smagic;
+    dsh = (shi - smagic) / static_cast<Real>(nh);
+
+    g_d.resize(n + 1);
+    dg_d.resize(n + 1);
+    h_d.resize(nh + 1);
+    dh_d.resize(nh + 1);
+    Gpu::copyAsync(Gpu::hostToDevice, g.begin(), g.end(), g_d.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, dg.begin(), dg.end(), dg_d.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, h.begin(), h.end(), h_d.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, dh.begin(), dh.end(), dh_d.begin());
+    Gpu::streamSynchronize();
+
+    if (verbose > 0 && ParallelDescriptor::IOProcessor()) {
+        std::cout << "Blackbody table: " << n + nh + 2 << " points, max relative error "
+                  << err << std::endl;
+    }
+}
+
+BlackbodyTableView
+BlackbodyTable::view () const
+{
+    BlackbodyTableView tab;
+
+    tab.lo.f = g_d.data();
+    tab.lo.df = dg_d.data();
+    tab.lo.n = n;
+    tab.lo.s0 = s0;
+    tab.lo.ds = ds;
+    tab.lo.dsinv = 1.0_rt / ds;
+
+    tab.hi.f = h_d.data();
+    tab.hi.df = dh_d.data();
+    tab.hi.n = nh;
+    tab.hi.s0 = sh0;
+    tab.hi.ds = dsh;
+    tab.hi.dsinv = 1.0_rt / dsh;
+
+    return tab;
+}
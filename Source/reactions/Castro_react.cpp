@@ -189,11 +189,16 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
 #if defined(AMREX_USE_GPU)
     Gpu::Buffer<int> d_num_failed({0});
     auto* p_num_failed = d_num_failed.data();
+    Gpu::Buffer<int> d_num_local_retries({0});
+    auto* p_num_local_retries = d_num_local_retries.data();
 #endif
     int num_failed = 0;
+    int num_local_retries = 0;
+
+    const int max_local_retries = local_burn_retries;
 
 #ifdef _OPENMP
-#pragma omp parallel reduction(+:num_failed)
+#pragma omp parallel reduction(+:num_failed,num_local_retries)
 #endif
     for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
@@ -236,6 +241,7 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
             bool do_burn = true;
             burn_state.success = true;
             int burn_failed = 0;
+            int burn_retried = 0;
 
             // Don't burn on zones inside shock regions, if the relevant option is set.
 
@@ -329,8 +335,48 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
             }
 
             if (do_burn) {
+
+                // keep the initial state in case we need to redo the burn
+
+                burn_t burn_state_in = burn_state;
+
                 burner(burn_state, dt);
 
+                // If the burn failed, try again in this zone alone,
+                // splitting the burn into successively more substeps,
+                // rather than failing (and retrying) the whole level.
+
+                for (int n_retry = 1; n_retry <= max_local_retries && !burn_state.success; ++n_retry) {
+
+                    const int nsub = 1 << n_retry;
+                    const Real dt_sub = dt / static_cast<Real>(nsub);
+
+                    int n_rhs = burn_state.n_rhs;
+                    int n_jac = burn_state.n_jac;
+
+                    burn_state = burn_state_in;
+
+                    for (int isub = 0; isub < nsub; ++isub) {
+                        burn_state.success = true;
+                        burn_state.n_rhs = 0;
+                        burn_state.n_jac = 0;
+
+                        burner(burn_state, dt_sub);
+
+                        n_rhs += burn_state.n_rhs;
+                        n_jac += burn_state.n_jac;
+
+                        if (!burn_state.success) {
+                            break;
+                        }
+                    }
+
+                    burn_state.n_rhs = n_rhs;
+                    burn_state.n_jac = n_jac;
+
+                    burn_retried = 1;
+                }
+
                 // If we were unsuccessful, update the failure count.
 
                 if (!burn_state.success) {
@@ -408,8 +454,12 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
             if (burn_failed) {
                 Gpu::Atomic::Add(p_num_failed, burn_failed);
             }
+            if (burn_retried) {
+                Gpu::Atomic::Add(p_num_local_retries, burn_retried);
+            }
 #else
             num_failed += burn_failed;
+            num_local_retries += burn_retried;
 #endif
         });
 
@@ -420,12 +470,22 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
 
 #if defined(AMREX_USE_GPU)
     num_failed = *(d_num_failed.copyToHost());
+    num_local_retries = *(d_num_local_retries.copyToHost());
 #endif
 
     burn_success = !num_failed;
 
     ParallelDescriptor::ReduceIntMin(burn_success);
 
+    if (verbose && max_local_retries > 0) {
+        ParallelDescriptor::ReduceIntSum(num_local_retries, ParallelDescriptor::IOProcessorNumber());
+
+        if (num_local_retries > 0) {
+            amrex::Print() << "... " << num_local_retries << " zone(s) on level " << level
+                           << " needed a zone-local burn retry" << std::endl << std::endl;
+        }
+    }
+
     if (print_update_diagnostics) {
 
         Real e_added = r.sum(0);